@@ -84,6 +84,9 @@
 #ifndef ME_GOAHEAD_ACCESS_LOG
     #define ME_GOAHEAD_ACCESS_LOG 0
 #endif
+#ifndef ME_GOAHEAD_ACTION_THREADS
+    #define ME_GOAHEAD_ACTION_THREADS 4
+#endif
 #ifndef ME_GOAHEAD_AUTH
     #define ME_GOAHEAD_AUTH 1
 #endif
@@ -105,21 +108,33 @@
 #ifndef ME_GOAHEAD_CLIENT_CACHE_LIFESPAN
     #define ME_GOAHEAD_CLIENT_CACHE_LIFESPAN 86400
 #endif
+#ifndef ME_GOAHEAD_CORK
+    #define ME_GOAHEAD_CORK 0
+#endif
 #ifndef ME_GOAHEAD_DIGEST
     #define ME_GOAHEAD_DIGEST 1
 #endif
 #ifndef ME_GOAHEAD_DOCUMENTS
     #define ME_GOAHEAD_DOCUMENTS "web"
 #endif
+#ifndef ME_GOAHEAD_EPOLL
+    #define ME_GOAHEAD_EPOLL 1
+#endif
 #ifndef ME_GOAHEAD_JAVASCRIPT
     #define ME_GOAHEAD_JAVASCRIPT 1
 #endif
 #ifndef ME_GOAHEAD_LEGACY
     #define ME_GOAHEAD_LEGACY 0
 #endif
+#ifndef ME_GOAHEAD_LIMIT_ACCEPT
+    #define ME_GOAHEAD_LIMIT_ACCEPT 16
+#endif
 #ifndef ME_GOAHEAD_LIMIT_BUFFER
     #define ME_GOAHEAD_LIMIT_BUFFER 1024
 #endif
+#ifndef ME_GOAHEAD_LIMIT_BUFFER_MAX
+    #define ME_GOAHEAD_LIMIT_BUFFER_MAX 65536
+#endif
 #ifndef ME_GOAHEAD_LIMIT_CGI_ARGS
     #define ME_GOAHEAD_LIMIT_CGI_ARGS 4096
 #endif
@@ -138,12 +153,18 @@
 #ifndef ME_GOAHEAD_LIMIT_NUM_HEADERS
     #define ME_GOAHEAD_LIMIT_NUM_HEADERS 64
 #endif
+#ifndef ME_GOAHEAD_LIMIT_OUTPUT
+    #define ME_GOAHEAD_LIMIT_OUTPUT 262144
+#endif
 #ifndef ME_GOAHEAD_LIMIT_PARSE_TIMEOUT
     #define ME_GOAHEAD_LIMIT_PARSE_TIMEOUT 5
 #endif
 #ifndef ME_GOAHEAD_LIMIT_PASSWORD
     #define ME_GOAHEAD_LIMIT_PASSWORD 32
 #endif
+#ifndef ME_GOAHEAD_LIMIT_POOL
+    #define ME_GOAHEAD_LIMIT_POOL 16
+#endif
 #ifndef ME_GOAHEAD_LIMIT_POST
     #define ME_GOAHEAD_LIMIT_POST 16384
 #endif
@@ -222,6 +243,9 @@
 #ifndef ME_GOAHEAD_SSL_VERIFY_PEER
     #define ME_GOAHEAD_SSL_VERIFY_PEER 0
 #endif
+#ifndef ME_GOAHEAD_STATS
+    #define ME_GOAHEAD_STATS 1
+#endif
 #ifndef ME_GOAHEAD_STEALTH
     #define ME_GOAHEAD_STEALTH 1
 #endif
@@ -234,6 +258,9 @@
 #ifndef ME_GOAHEAD_UPLOAD_DIR
     #define ME_GOAHEAD_UPLOAD_DIR "tmp"
 #endif
+#ifndef ME_GOAHEAD_WORKERS
+    #define ME_GOAHEAD_WORKERS 0
+#endif
 #ifndef ME_GOAHEAD_XFRAME_HEADER
     #define ME_GOAHEAD_XFRAME_HEADER "SAMEORIGIN"
 #endif
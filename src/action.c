@@ -15,6 +15,58 @@
 /************************************ Locals **********************************/
 
 static WebsHash actionTable = -1;            /* Symbol table for actions */
+static WebsHash asyncTable = -1;             /* Symbol table for asynchronous actions */
+
+/*
+    Asynchronous action definition
+ */
+typedef struct AsyncDef {
+    WebsAsyncAction     fn;                 /* Callback to run on a worker thread */
+    WebsAsyncDone       done;               /* Completion callback to run on the event loop thread */
+} AsyncDef;
+
+#if ME_UNIX_LIKE && ME_GOAHEAD_ACTION_THREADS > 0 && !ME_GOAHEAD_REPLACE_MALLOC
+#define ASYNC_THREADS 1
+
+/*
+    Asynchronous action request. Jobs are queued for the worker threads and then placed on the done list. The worker
+    signals the event loop via the wakeup descriptor and the event loop completes the request.
+ */
+typedef struct AsyncJob {
+    struct AsyncJob     *next;
+    Webs                *wp;                /* Request. Only used on the event loop thread */
+    WebsAsync           *async;             /* Copy of the request inputs for the worker thread */
+    AsyncDef            *def;               /* Action definition */
+    char                *result;            /* Result from the action callback */
+    int                 mask;               /* Socket handler mask to restore on completion */
+} AsyncJob;
+
+static pthread_t        asyncThreads[ME_GOAHEAD_ACTION_THREADS];
+static pthread_mutex_t  asyncLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t   asyncCond = PTHREAD_COND_INITIALIZER;
+static AsyncJob         *asyncQueue;        /* Jobs waiting for a worker thread */
+static AsyncJob         *asyncQueueTail;
+static AsyncJob         *asyncDone;         /* Completed jobs waiting for the event loop */
+static int              asyncThreadCount;   /* Number of running worker threads */
+static int              asyncStopping;      /* Worker threads should exit */
+static int              wakeRead = -1;      /* Wakeup descriptor read by the event loop */
+static int              wakeWrite = -1;     /* Wakeup descriptor written by worker threads */
+static int              wakeSid = -1;       /* Socket object for wakeRead */
+#endif
+
+/***************************** Forward Declarations ***************************/
+
+static WebsAsync *copyRequest(Webs *wp);
+static char *copyString(char **cp, cchar *str);
+static void runAsync(Webs *wp, AsyncDef *def);
+static void writeAsyncResult(Webs *wp, char *result);
+#if ASYNC_THREADS
+static void *asyncMain(void *arg);
+static void asyncWakeEvent(int sid, int mask, void *data);
+static void completeAsync(AsyncJob *job);
+static int startAsync();
+static void stopAsync();
+#endif
 
 /************************************* Code ***********************************/
 /*
@@ -48,7 +100,11 @@ static bool actionHandler(Webs *wp)
      */
     sp = hashLookup(actionTable, actionName);
     if (sp == NULL) {
-        websError(wp, HTTP_CODE_NOT_FOUND, "Action %s is not defined", actionName);
+        if ((sp = hashLookup(asyncTable, actionName)) != NULL) {
+            runAsync(wp, (AsyncDef*) sp->content.value.symbol);
+        } else {
+            websError(wp, HTTP_CODE_NOT_FOUND, "Action %s is not defined", actionName);
+        }
     } else {
         fn = (WebsAction) sp->content.value.symbol;
         assert(fn);
@@ -80,18 +136,411 @@ PUBLIC int websDefineAction(cchar *name, void *fn)
 }
 
 
+/*
+    Define a function in the "action" map space that runs on a worker thread
+ */
+PUBLIC int websDefineAsyncAction(cchar *name, WebsAsyncAction fn, WebsAsyncDone done)
+{
+    WebsKey     *sp;
+    AsyncDef    *def;
+
+    assert(name && *name);
+    assert(fn);
+
+    if (fn == NULL) {
+        return -1;
+    }
+    if ((def = walloc(sizeof(AsyncDef))) == NULL) {
+        return -1;
+    }
+    def->fn = fn;
+    def->done = done;
+    if ((sp = hashLookup(asyncTable, name)) != NULL) {
+        wfree(sp->content.value.symbol);
+    }
+    hashEnter(asyncTable, (char*) name, valueSymbol(def), 0);
+    return 0;
+}
+
+
+/*
+    Get a request variable from the copy of the request inputs. This is safe to call from the action worker thread.
+ */
+PUBLIC cchar *websGetAsyncVar(WebsAsync *async, cchar *var, cchar *defaultValue)
+{
+    char    **vp;
+
+    assert(async);
+    assert(var && *var);
+
+    for (vp = async->vars; *vp; vp += 2) {
+        if (strcmp(*vp, var) == 0) {
+            return vp[1];
+        }
+    }
+    return defaultValue;
+}
+
+
+/*
+    Copy the request inputs for an asynchronous action. The copy is one allocation holding the WebsAsync structure,
+    the vars array and the strings, so the action reads no state shared with the event loop thread.
+ */
+static WebsAsync *copyRequest(Webs *wp)
+{
+    WebsAsync   *async;
+    WebsKey     *sp;
+    char        *cp, **vp;
+    ssize       size;
+    int         count;
+
+    /*
+        Define the header vars so they are included in the copy
+     */
+    websSetHeaderVars(wp);
+    count = 0;
+    size = slen(wp->method) + slen(wp->path) + slen(wp->query) + 3;
+    if (wp->vars >= 0) {
+        for (sp = hashFirst(wp->vars); sp; sp = hashNext(wp->vars, sp)) {
+            size += slen(sp->name.value.string) + slen(sp->content.value.string) + 2;
+            count++;
+        }
+    }
+    size += sizeof(WebsAsync) + (count * 2 + 1) * sizeof(char*);
+    if ((async = walloc(size)) == NULL) {
+        return NULL;
+    }
+    vp = async->vars = (char**) &async[1];
+    cp = (char*) &vp[count * 2 + 1];
+    async->method = copyString(&cp, wp->method);
+    async->path = copyString(&cp, wp->path);
+    async->query = copyString(&cp, wp->query);
+    if (wp->vars >= 0) {
+        for (sp = hashFirst(wp->vars); sp; sp = hashNext(wp->vars, sp)) {
+            *vp++ = copyString(&cp, sp->name.value.string);
+            *vp++ = copyString(&cp, sp->content.value.string);
+        }
+    }
+    *vp = 0;
+    return async;
+}
+
+
+/*
+    Copy a string to *cp and advance *cp beyond it. A NULL string is copied as empty.
+ */
+static char *copyString(char **cp, cchar *str)
+{
+    char    *result;
+    ssize   len;
+
+    result = *cp;
+    len = slen(str);
+    if (len > 0) {
+        memcpy(result, str, len);
+    }
+    result[len] = '\0';
+    *cp += len + 1;
+    return result;
+}
+
+
+/*
+    Write the result of an asynchronous action if there is no completion callback
+ */
+static void writeAsyncResult(Webs *wp, char *result)
+{
+    websSetStatus(wp, 200);
+    websWriteHeaders(wp, -1, 0);
+    websWriteEndHeaders(wp);
+    if (result) {
+        websWriteBlock(wp, result, strlen(result));
+    }
+    websDone(wp);
+}
+
+
+/*
+    Run an asynchronous action. Without worker threads, the action runs immediately on the event loop thread.
+ */
+static void runAsync(Webs *wp, AsyncDef *def)
+{
+    WebsAsync   *async;
+    char        *result;
+#if ASYNC_THREADS
+    AsyncJob    *job;
+#endif
+
+    if ((async = copyRequest(wp)) == NULL) {
+        websError(wp, HTTP_CODE_INTERNAL_SERVER_ERROR, "Cannot allocate request copy");
+        return;
+    }
+#if ASYNC_THREADS
+    if ((asyncThreadCount > 0 || startAsync() == 0) && (job = walloc(sizeof(AsyncJob))) != NULL) {
+        memset(job, 0, sizeof(AsyncJob));
+        job->wp = wp;
+        job->async = async;
+        job->def = def;
+        /*
+            Stop servicing the connection until the job is complete
+         */
+        job->mask = socketPtr(wp->sid)->handlerMask;
+        socketRegisterInterest(wp->sid, 0);
+        wp->flags |= WEBS_ASYNC;
+
+        pthread_mutex_lock(&asyncLock);
+        if (asyncQueueTail) {
+            asyncQueueTail->next = job;
+        } else {
+            asyncQueue = job;
+        }
+        asyncQueueTail = job;
+        pthread_cond_signal(&asyncCond);
+        pthread_mutex_unlock(&asyncLock);
+        return;
+    }
+#endif
+    result = (def->fn)(async);
+    if (def->done) {
+        (def->done)(wp, result);
+    } else {
+        writeAsyncResult(wp, result);
+    }
+    wfree(result);
+    wfree(async);
+}
+
+
+#if ASYNC_THREADS
+/*
+    Create the wakeup descriptor and start the worker threads. This is deferred until first use so that worker
+    processes forked after websOpen create their own threads.
+ */
+static int startAsync()
+{
+    sigset_t    mask, prior;
+    int         i;
+#if !LINUX
+    int         fds[2];
+#endif
+
+    if (asyncStopping) {
+        return -1;
+    }
+#if LINUX
+    if ((wakeRead = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)) < 0) {
+        error("Cannot create eventfd for asynchronous actions, errno %d", errno);
+        return -1;
+    }
+    wakeWrite = wakeRead;
+#else
+    if (pipe(fds) < 0) {
+        error("Cannot create pipe for asynchronous actions, errno %d", errno);
+        return -1;
+    }
+    wakeRead = fds[0];
+    wakeWrite = fds[1];
+    for (i = 0; i < 2; i++) {
+        fcntl(fds[i], F_SETFL, fcntl(fds[i], F_GETFL) | O_NONBLOCK);
+        fcntl(fds[i], F_SETFD, FD_CLOEXEC);
+    }
+#endif
+    if ((wakeSid = socketAllocFd(wakeRead)) < 0) {
+        stopAsync();
+        return -1;
+    }
+    socketCreateHandler(wakeSid, SOCKET_READABLE, asyncWakeEvent, 0);
+
+    /*
+        Signals must be delivered to the event loop thread so they interrupt the wait for events
+     */
+    sigfillset(&mask);
+    pthread_sigmask(SIG_BLOCK, &mask, &prior);
+    for (i = 0; i < ME_GOAHEAD_ACTION_THREADS; i++) {
+        if (pthread_create(&asyncThreads[i], NULL, asyncMain, NULL) != 0) {
+            error("Cannot create action thread, errno %d", errno);
+            break;
+        }
+        asyncThreadCount++;
+    }
+    pthread_sigmask(SIG_SETMASK, &prior, NULL);
+    if (asyncThreadCount == 0) {
+        stopAsync();
+        return -1;
+    }
+    trace(2, "Started %d action threads", asyncThreadCount);
+    return 0;
+}
+
+
+/*
+    Stop the worker threads. Running actions are allowed to complete, but their results are discarded.
+ */
+static void stopAsync()
+{
+    AsyncJob    *job, *next;
+    int         i;
+
+    pthread_mutex_lock(&asyncLock);
+    asyncStopping = 1;
+    pthread_cond_broadcast(&asyncCond);
+    pthread_mutex_unlock(&asyncLock);
+
+    for (i = 0; i < asyncThreadCount; i++) {
+        pthread_join(asyncThreads[i], NULL);
+    }
+    asyncThreadCount = 0;
+    for (job = asyncQueue; job; job = next) {
+        next = job->next;
+        wfree(job->async);
+        wfree(job);
+    }
+    for (job = asyncDone; job; job = next) {
+        next = job->next;
+        wfree(job->result);
+        wfree(job->async);
+        wfree(job);
+    }
+    asyncQueue = asyncQueueTail = asyncDone = 0;
+    if (wakeSid >= 0) {
+        /* Closes wakeRead */
+        socketFree(wakeSid);
+        wakeSid = -1;
+    } else if (wakeRead >= 0) {
+        close(wakeRead);
+    }
+    if (wakeWrite >= 0 && wakeWrite != wakeRead) {
+        close(wakeWrite);
+    }
+    wakeRead = wakeWrite = -1;
+}
+
+
+/*
+    Worker thread main loop
+ */
+static void *asyncMain(void *arg)
+{
+    AsyncJob    *job;
+    uint64      value;
+    ssize       rc;
+
+    while (1) {
+        pthread_mutex_lock(&asyncLock);
+        while (!asyncQueue && !asyncStopping) {
+            pthread_cond_wait(&asyncCond, &asyncLock);
+        }
+        if (asyncStopping) {
+            pthread_mutex_unlock(&asyncLock);
+            break;
+        }
+        job = asyncQueue;
+        if ((asyncQueue = job->next) == 0) {
+            asyncQueueTail = 0;
+        }
+        pthread_mutex_unlock(&asyncLock);
+
+        job->result = (job->def->fn)(job->async);
+
+        pthread_mutex_lock(&asyncLock);
+        job->next = asyncDone;
+        asyncDone = job;
+        pthread_mutex_unlock(&asyncLock);
+
+        /* Wake the event loop. An eventfd requires an 8 byte write */
+        value = 1;
+        do {
+            rc = write(wakeWrite, &value, wakeWrite == wakeRead ? sizeof(value) : 1);
+        } while (rc < 0 && errno == EINTR);
+    }
+    return NULL;
+}
+
+
+/*
+    Event loop handler for the wakeup descriptor. Complete the finished jobs in the order they finished.
+ */
+static void asyncWakeEvent(int sid, int mask, void *data)
+{
+    AsyncJob    *job, *next, *list;
+    char        buf[64];
+
+    while (read(wakeRead, buf, sizeof(buf)) > 0) {}
+
+    pthread_mutex_lock(&asyncLock);
+    job = asyncDone;
+    asyncDone = 0;
+    pthread_mutex_unlock(&asyncLock);
+
+    for (list = 0; job; job = next) {
+        next = job->next;
+        job->next = list;
+        list = job;
+    }
+    for (job = list; job; job = next) {
+        next = job->next;
+        completeAsync(job);
+    }
+}
+
+
+/*
+    Resume servicing the connection and write the response on the event loop thread
+ */
+static void completeAsync(AsyncJob *job)
+{
+    Webs    *wp;
+
+    wp = job->wp;
+    wp->flags &= ~WEBS_ASYNC;
+    websNoteRequestActivity(wp);
+    socketRegisterInterest(wp->sid, job->mask);
+
+    if (job->def->done) {
+        (job->def->done)(wp, job->result);
+    } else {
+        writeAsyncResult(wp, job->result);
+    }
+    wfree(job->result);
+    wfree(job->async);
+    wfree(job);
+
+    if (wp->state != WEBS_RUNNING) {
+        websPump(wp);
+    }
+    if (wp->flags & WEBS_CLOSED) {
+        websFree(wp);
+    }
+}
+#endif /* ASYNC_THREADS */
+
+
 static void closeAction()
 {
+    WebsKey     *sp;
+
+#if ASYNC_THREADS
+    stopAsync();
+    asyncStopping = 0;
+#endif
     if (actionTable != -1) {
         hashFree(actionTable);
         actionTable = -1;
     }
+    if (asyncTable != -1) {
+        for (sp = hashFirst(asyncTable); sp; sp = hashNext(asyncTable, sp)) {
+            wfree(sp->content.value.symbol);
+        }
+        hashFree(asyncTable);
+        asyncTable = -1;
+    }
 }
 
 
 PUBLIC void websActionOpen()
 {
     actionTable = hashCreate(WEBS_HASH_INIT);
+    asyncTable = hashCreate(WEBS_HASH_INIT);
     websDefineHandler("action", 0, actionHandler, closeAction, 0);
 }
 
@@ -19,12 +19,23 @@
 /********************************** Locals ************************************/
 
 static WebsMemNotifier memNotifier;
+static int64 allocCount;                        /* Number of allocations and reallocations */
 
 PUBLIC void websSetMemNotifier(WebsMemNotifier cback)
 {
     memNotifier = cback;
 }
 
+
+/*
+    Return the number of allocations since the server started. This is not locked and is approximate if async
+    action threads allocate concurrently.
+ */
+PUBLIC int64 wallocCount()
+{
+    return allocCount;
+}
+
 /********************************* Defines ************************************/
 #if ME_GOAHEAD_REPLACE_MALLOC
 /*
@@ -122,6 +133,7 @@ PUBLIC void *walloc(ssize size)
     if (size < 0) {
         return NULL;
     }
+    allocCount++;
     memSize = wallocGetSize(size, &q);
 
     if (q >= WEBS_MAX_CLASS) {
@@ -277,6 +289,7 @@ PUBLIC void *walloc(ssize num)
 {
     void    *mem;
 
+    allocCount++;
     if ((mem = malloc(num)) == 0) {
         if (memNotifier) {
             (memNotifier)(num);
@@ -299,6 +312,7 @@ PUBLIC void *wrealloc(void *mem, ssize num)
     void    *old;
 
     old = mem;
+    allocCount++;
     if ((mem = realloc(mem, num)) == 0) {
         if (memNotifier) {
             (memNotifier)(num);
@@ -98,8 +98,7 @@ PUBLIC bool websAuthenticate(Webs *wp)
          */
         if ((username = (char*) websGetSessionVar(wp, WEBS_SESSION_USERNAME, 0)) != 0) {
             cached = 1;
-            wfree(wp->username);
-            wp->username = sclone(username);
+            wp->username = arenaClone(&wp->arena, username);
         }
     }
     if (!cached) {
@@ -490,10 +489,8 @@ PUBLIC bool websLoginUser(Webs *wp, cchar *username, cchar *password)
     if (!wp->route || !wp->route->verify) {
         return 0;
     }
-    wfree(wp->username);
-    wp->username = sclone(username);
-    wfree(wp->password);
-    wp->password = sclone(password);
+    wp->username = arenaClone(&wp->arena, username);
+    wp->password = arenaClone(&wp->arena, password);
 
     if (!(wp->route->verify)(wp)) {
         trace(2, "Password does not match");
@@ -560,8 +557,7 @@ static void basicLogin(Webs *wp)
 {
     assert(wp);
     assert(wp->route);
-    wfree(wp->authResponse);
-    wp->authResponse = sfmt("Basic realm=\"%s\"", ME_GOAHEAD_REALM);
+    wp->authResponse = arenaFmt(&wp->arena, "Basic realm=\"%s\"", ME_GOAHEAD_REALM);
 }
 
 
@@ -579,7 +575,7 @@ WebsVerify websGetPasswordStoreVerify()
 
 PUBLIC bool websVerifyPasswordFromFile(Webs *wp)
 {
-    char    passbuf[ME_GOAHEAD_LIMIT_PASSWORD * 3 + 3];
+    char    passbuf[ME_GOAHEAD_LIMIT_PASSWORD * 3 + 3], *password;
     bool    success;
 
     assert(wp);
@@ -593,8 +589,9 @@ PUBLIC bool websVerifyPasswordFromFile(Webs *wp)
      */
     if (!wp->encoded) {
         fmt(passbuf, sizeof(passbuf), "%s:%s:%s", wp->username, ME_GOAHEAD_REALM, wp->password);
-        wfree(wp->password);
-        wp->password = websMD5(passbuf);
+        password = websMD5(passbuf);
+        wp->password = arenaClone(&wp->arena, password);
+        wfree(password);
         wp->encoded = 1;
     }
     if (wp->digest) {
@@ -746,15 +743,13 @@ static bool parseBasicDetails(Webs *wp)
             *cp++ = '\0';
         }
     }
-    wfree(wp->username);
-    wfree(wp->password);
     if (cp) {
-        wp->username = sclone(userAuth);
-        wp->password = sclone(cp);
+        wp->username = arenaClone(&wp->arena, userAuth);
+        wp->password = arenaClone(&wp->arena, cp);
         wp->encoded = 0;
     } else {
-        wp->username = sclone("");
-        wp->password = sclone("");
+        wp->username = arenaClone(&wp->arena, "");
+        wp->password = arenaClone(&wp->arena, "");
     }
     wfree(userAuth);
     return 1;
@@ -772,8 +767,7 @@ static void digestLogin(Webs *wp)
     nonce = createDigestNonce(wp);
     /* Opaque is unused. Set to anything */
     opaque = "5ccc069c403ebaf9f0171e9517f40e41";
-    wfree(wp->authResponse);
-    wp->authResponse = sfmt(
+    wp->authResponse = arenaFmt(&wp->arena,
         "Digest realm=\"%s\", domain=\"%s\", qop=\"%s\", nonce=\"%s\", opaque=\"%s\", algorithm=\"%s\", stale=\"%s\"",
         ME_GOAHEAD_REALM, websGetServerUrl(), "auth", nonce, opaque, "MD5", "FALSE");
     wfree(nonce);
@@ -782,12 +776,20 @@ static void digestLogin(Webs *wp)
 
 static bool parseDigestDetails(Webs *wp)
 {
-    WebsTime    when;
-    char        *decoded, *value, *tok, *key, *keyBuf, *dp, *sp, *secret, *realm;
-    int         seenComma;
+    WebsDigestState *ds;
+    WebsTime        when;
+    char            *decoded, *digest, *value, *tok, *key, *dp, *sp, *secret, *realm;
+    int             seenComma;
 
     assert(wp);
-    key = keyBuf = sclone(wp->authDetails);
+    if ((ds = wp->digestState) == 0) {
+        if ((ds = arenaAlloc(&wp->arena, sizeof(WebsDigestState))) == 0) {
+            return 0;
+        }
+        wp->digestState = ds;
+    }
+    memset(ds, 0, sizeof(WebsDigestState));
+    key = arenaClone(&wp->arena, wp->authDetails);
 
     while (*key) {
         while (*key && isspace((uchar) *key)) {
@@ -848,8 +850,7 @@ static bool parseDigestDetails(Webs *wp)
 
         case 'c':
             if (scaselesscmp(key, "cnonce") == 0) {
-                wfree(wp->cnonce);
-                wp->cnonce = sclone(value);
+                ds->cnonce = arenaClone(&wp->arena, value);
             }
             break;
 
@@ -861,36 +862,30 @@ static bool parseDigestDetails(Webs *wp)
 
         case 'n':
             if (scaselesscmp(key, "nc") == 0) {
-                wfree(wp->nc);
-                wp->nc = sclone(value);
+                ds->nc = arenaClone(&wp->arena, value);
             } else if (scaselesscmp(key, "nonce") == 0) {
-                wfree(wp->nonce);
-                wp->nonce = sclone(value);
+                ds->nonce = arenaClone(&wp->arena, value);
             }
             break;
 
         case 'o':
             if (scaselesscmp(key, "opaque") == 0) {
-                wfree(wp->opaque);
-                wp->opaque = sclone(value);
+                ds->opaque = arenaClone(&wp->arena, value);
             }
             break;
 
         case 'q':
             if (scaselesscmp(key, "qop") == 0) {
-                wfree(wp->qop);
-                wp->qop = sclone(value);
+                ds->qop = arenaClone(&wp->arena, value);
             }
             break;
 
         case 'r':
             if (scaselesscmp(key, "realm") == 0) {
-                wfree(wp->realm);
-                wp->realm = sclone(value);
+                wp->realm = arenaClone(&wp->arena, value);
             } else if (scaselesscmp(key, "response") == 0) {
                 /* Store the response digest in the password field. This is MD5(user:realm:password) */
-                wfree(wp->password);
-                wp->password = sclone(value);
+                wp->password = arenaClone(&wp->arena, value);
                 wp->encoded = 1;
             }
             break;
@@ -902,11 +897,9 @@ static bool parseDigestDetails(Webs *wp)
 
         case 'u':
             if (scaselesscmp(key, "uri") == 0) {
-                wfree(wp->digestUri);
-                wp->digestUri = sclone(value);
+                ds->digestUri = arenaClone(&wp->arena, value);
             } else if (scaselesscmp(key, "username") == 0 || scaselesscmp(key, "user") == 0) {
-                wfree(wp->username);
-                wp->username = sclone(value);
+                wp->username = arenaClone(&wp->arena, value);
             }
             break;
 
@@ -924,22 +917,21 @@ static bool parseDigestDetails(Webs *wp)
             }
         }
     }
-    wfree(keyBuf);
 
-    if (wp->username == 0 || wp->realm == 0 || wp->nonce == 0 || wp->route == 0 || wp->password == 0) {
+    if (wp->username == 0 || wp->realm == 0 || ds->nonce == 0 || wp->route == 0 || wp->password == 0) {
         return 0;
     }
-    if (wp->qop && (wp->cnonce == 0 || wp->nc == 0)) {
+    if (ds->qop && (ds->cnonce == 0 || ds->nc == 0)) {
         return 0;
     }
-    if (wp->qop == 0) {
-        wp->qop = sclone("");
+    if (ds->qop == 0) {
+        ds->qop = arenaClone(&wp->arena, "");
     }
     /*
         Validate the nonce value - prevents replay attacks
      */
     when = 0; secret = 0; realm = 0;
-    decoded = parseDigestNonce(wp->nonce, &secret, &realm, &when);
+    decoded = parseDigestNonce(ds->nonce, &secret, &realm, &when);
     if (!smatch(masterSecret, secret)) {
         trace(2, "Access denied: Nonce mismatch");
         wfree(decoded);
@@ -948,7 +940,7 @@ static bool parseDigestDetails(Webs *wp)
         trace(2, "Access denied: Realm mismatch");
         wfree(decoded);
         return 0;
-    } else if (!smatch(wp->qop, "auth")) {
+    } else if (!smatch(ds->qop, "auth")) {
         trace(2, "Access denied: Bad qop");
         wfree(decoded);
         return 0;
@@ -965,8 +957,9 @@ static bool parseDigestDetails(Webs *wp)
         }
     }
     wfree(decoded);
-    wfree(wp->digest);
-    wp->digest = calcDigest(wp, 0, wp->user->password);
+    digest = calcDigest(wp, 0, wp->user->password);
+    wp->digest = arenaClone(&wp->arena, digest);
+    wfree(digest);
     return 1;
 }
 
@@ -1012,11 +1005,14 @@ static char *parseDigestNonce(char *nonce, char **secret, char **realm, WebsTime
  */
 static char *calcDigest(Webs *wp, char *username, char *password)
 {
-    char  a1Buf[256], a2Buf[256], digestBuf[256];
-    char  *ha1, *ha2, *method, *result;
+    WebsDigestState *ds;
+    char            a1Buf[256], a2Buf[256], digestBuf[256];
+    char            *ha1, *ha2, *method, *result;
 
     assert(wp);
     assert(password);
+    ds = wp->digestState;
+    assert(ds);
 
     /*
         Compute HA1. If username == 0, then the password is already expected to be in the HA1 format
@@ -1033,20 +1029,20 @@ static char *calcDigest(Webs *wp, char *username, char *password)
         HA2
      */
     method = wp->method;
-    fmt(a2Buf, sizeof(a2Buf), "%s:%s", method, wp->digestUri);
+    fmt(a2Buf, sizeof(a2Buf), "%s:%s", method, ds->digestUri);
     ha2 = websMD5(a2Buf);
 
     /*
         H(HA1:nonce:HA2)
      */
-    if (scmp(wp->qop, "auth") == 0) {
-        fmt(digestBuf, sizeof(digestBuf), "%s:%s:%s:%s:%s:%s", ha1, wp->nonce, wp->nc, wp->cnonce, wp->qop, ha2);
+    if (scmp(ds->qop, "auth") == 0) {
+        fmt(digestBuf, sizeof(digestBuf), "%s:%s:%s:%s:%s:%s", ha1, ds->nonce, ds->nc, ds->cnonce, ds->qop, ha2);
 
-    } else if (scmp(wp->qop, "auth-int") == 0) {
-        fmt(digestBuf, sizeof(digestBuf), "%s:%s:%s:%s:%s:%s", ha1, wp->nonce, wp->nc, wp->cnonce, wp->qop, ha2);
+    } else if (scmp(ds->qop, "auth-int") == 0) {
+        fmt(digestBuf, sizeof(digestBuf), "%s:%s:%s:%s:%s:%s", ha1, ds->nonce, ds->nc, ds->cnonce, ds->qop, ha2);
 
     } else {
-        fmt(digestBuf, sizeof(digestBuf), "%s:%s:%s", ha1, wp->nonce, ha2);
+        fmt(digestBuf, sizeof(digestBuf), "%s:%s:%s", ha1, ds->nonce, ha2);
     }
     result = websMD5(digestBuf);
     wfree(ha1);
@@ -34,6 +34,7 @@ typedef struct Cgi {            /* Struct for CGI tasks which have completed */
     char    **envp;             /* Pointer to array of environment strings */
     CgiPid  handle;             /* Process handle of the task */
     off_t   fplacemark;         /* Seek location for CGI output file */
+    int     blocked;            /* Client is not accepting more output */
 } Cgi;
 
 static Cgi      **cgiList;      /* walloc chain list of wp's to be closed */
@@ -52,6 +53,7 @@ static CgiPid launchCgi(char *cgiPath, char **argp, char **envp, char *stdIn, ch
 PUBLIC bool cgiHandler(Webs *wp)
 {
     Cgi         *cgip;
+    WebsCgiState *cgi;
     WebsKey     *s;
     char        cgiPrefix[ME_GOAHEAD_LIMIT_FILENAME], *stdIn, *stdOut, cwd[ME_GOAHEAD_LIMIT_FILENAME];
     char        *cp, *cgiName, *cgiPath, **argp, **envp, **ep, *tok, *query, *dir, *extraPath, *exe, *vp;
@@ -174,7 +176,7 @@ PUBLIC bool cgiHandler(Webs *wp)
      */
     envpsize = 64;
     envp = walloc(envpsize * sizeof(char*));
-    if (wp->vars) {
+    if (wp->vars >= 0) {
         for (n = 0, s = hashFirst(wp->vars); s != NULL; s = hashNext(wp->vars, s)) {
             if (s->content.valid && s->content.type == string) {
                 vp = strim(s->name.value.string, 0, WEBS_TRIM_START);
@@ -203,15 +205,18 @@ PUBLIC bool cgiHandler(Webs *wp)
         Create temporary file name(s) for the child's stdin and stdout. For POST data the stdin temp file (and name)
         should already exist.
      */
-    if (wp->cgiStdin == NULL) {
-        wp->cgiStdin = websGetCgiCommName();
+    if ((cgi = wp->cgiState) != NULL) {
+        stdIn = cgi->stdIn;
+        if (cgi->fd >= 0) {
+            close(cgi->fd);
+            cgi->fd = -1;
+        }
+    } else {
+        cp = websGetCgiCommName();
+        stdIn = arenaClone(&wp->arena, cp);
+        wfree(cp);
     }
-    stdIn = wp->cgiStdin;
     stdOut = websGetCgiCommName();
-    if (wp->cgifd >= 0) {
-        close(wp->cgifd);
-        wp->cgifd = -1;
-    }
 
     /*
         Now launch the process.  If not successful, do the cleanup of resources.  If successful, the cleanup will be
@@ -242,6 +247,8 @@ PUBLIC bool cgiHandler(Webs *wp)
         cgip->envp = envp;
         cgip->wp = wp;
         cgip->fplacemark = 0;
+        /* Output is gathered by websCgiPoll which can resume after short writes */
+        wp->flags |= WEBS_NONBLOCK;
         wfree(query);
     }
     /*
@@ -265,7 +272,7 @@ PUBLIC bool websProcessCgiData(Webs *wp)
 
     nbytes = bufLen(&wp->input);
     trace(5, "cgi: write %d bytes to CGI program", nbytes);
-    if (write(wp->cgifd, wp->input.servp, (int) nbytes) != nbytes) {
+    if (write(wp->cgiState->fd, wp->input.servp, (int) nbytes) != nbytes) {
         websError(wp, HTTP_CODE_INTERNAL_SERVER_ERROR| WEBS_CLOSE, "Cannot write to CGI gateway");
     } else {
         trace(5, "cgi: write %d bytes to CGI program", nbytes);
@@ -360,7 +367,7 @@ PUBLIC void websCgiGatherOutput(Cgi *cgip)
     Webs        *wp;
     WebsStat    sbuf;
     char        buf[ME_GOAHEAD_LIMIT_HEADERS + 2];
-    ssize       nbytes, skip;
+    ssize       nbytes, skip, written;
     int         fdout;
 
     /*
@@ -375,6 +382,7 @@ PUBLIC void websCgiGatherOutput(Cgi *cgip)
                 Write the HTTP header on our first pass. The header must fit into ME_GOAHEAD_LIMIT_BUFFER.
              */
             wp = cgip->wp;
+            cgip->blocked = 0;
             lseek(fdout, cgip->fplacemark, SEEK_SET);
             while ((nbytes = read(fdout, buf, sizeof(buf))) > 0) {
                 skip = 0;
@@ -390,8 +398,17 @@ PUBLIC void websCgiGatherOutput(Cgi *cgip)
                     }
                 }
                 trace(5, "cgi: write %d bytes to client", nbytes - skip);
-                websWriteBlock(wp, &buf[skip], nbytes - skip);
-                cgip->fplacemark += (off_t) nbytes;
+                if ((written = websWriteBlock(wp, &buf[skip], nbytes - skip)) < 0) {
+                    /* Connection error. Discard the output */
+                    cgip->fplacemark = sbuf.st_size;
+                    break;
+                }
+                cgip->fplacemark += (off_t) (skip + written);
+                if (written < (nbytes - skip)) {
+                    /* Resume on a later poll once the client has accepted more output */
+                    cgip->blocked = 1;
+                    break;
+                }
             }
             close(fdout);
         } else {
@@ -416,12 +433,16 @@ int websCgiPoll()
         if ((cgip = cgiList[cid]) != NULL) {
             wp = cgip->wp;
             websCgiGatherOutput(cgip);
-            if (checkCgi(cgip->handle) == 0) {
+            if (cgip->handle == 0 || checkCgi(cgip->handle) == 0) {
                 /*
                     We get here if the CGI process has terminated. Clean up.
                  */
                 cgip->handle = 0;
                 websCgiGatherOutput(cgip);
+                if (cgip->blocked) {
+                    /* Wait until the client accepts the remaining output */
+                    continue;
+                }
 
 #if WINDOWS
                 /*
@@ -437,6 +458,10 @@ int websCgiPoll()
                     }
                 }
 #endif
+                /*
+                    The connection is freed below, so the response must not be deferred behind pipelined requests
+                 */
+                wp->flags &= ~WEBS_KEEP_ALIVE;
                 if (cgip->fplacemark == 0) {
                     websError(wp, HTTP_CODE_INTERNAL_SERVER_ERROR, "CGI generated no output");
                 } else {
@@ -449,8 +474,8 @@ int websCgiPoll()
                 unlink(cgip->stdIn);
                 unlink(cgip->stdOut);
                 /*
-                    Free all the memory buffers pointed to by cgip. The stdin file name (wp->cgiStdin) gets freed as
-                    part of websFree().
+                    Free all the memory buffers pointed to by cgip. The stdin file name (cgip->stdIn) is allocated
+                    from the request arena.
                  */
                 cgiMax = wfreeHandle(&cgiList, cid);
                 for (ep = cgip->envp; ep != NULL && *ep != NULL; ep++) {
@@ -462,8 +487,13 @@ int websCgiPoll()
                 wfree(cgip->envp);
                 wfree(cgip);
                 websPump(wp);
-                websFree(wp);
-                /* wp no longer valid */
+                if (wp->state == WEBS_RUNNING) {
+                    /* Output is still draining. The connection is closed and freed when the write completes. */
+                    wp->flags &= ~WEBS_KEEP_ALIVE;
+                } else {
+                    websFree(wp);
+                    /* wp no longer valid */
+                }
             }
         }
     }
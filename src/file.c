@@ -10,12 +10,18 @@
 
 /*********************************** Locals ***********************************/
 
+#define FILE_SEND_SIZE  (256 * 1024)        /* Maximum bytes per sendfile call */
+
 static char   *websIndex;                   /* Default page name */
 static char   *websDocuments;               /* Default Web page directory */
 
 /**************************** Forward Declarations ****************************/
 
 static void fileWriteEvent(Webs *wp);
+static void readFileData(Webs *wp, ssize size);
+#if LINUX && !ME_ROM && !__UCLIBC__
+static void sendFileData(Webs *wp);
+#endif
 
 /*********************************** Code *************************************/
 /*
@@ -94,7 +100,9 @@ static bool fileHandler(Webs *wp)
             websDone(wp);
             return 1;
         }
-        if (info.size > 0) {
+        if (info.size > 0 && info.size < bufRoom(&wp->output)) {
+            readFileData(wp, info.size);
+        } else if (info.size > 0) {
             websSetBackgroundWriter(wp, fileWriteEvent);
         } else {
             websDone(wp);
@@ -104,44 +112,101 @@ static bool fileHandler(Webs *wp)
 }
 
 
+/*
+    Read a small document into the output buffer after the headers. The response can then be written with a single
+    send and coalesced with the responses to pipelined requests.
+ */
+static void readFileData(Webs *wp, ssize size)
+{
+    WebsBuf     *op;
+    ssize       len;
+
+    op = &wp->output;
+    while (size > 0 && (len = websPageReadData(wp, (char*) op->endp, size)) > 0) {
+        bufAdjustEnd(op, len);
+        size -= len;
+    }
+    bufAddNull(op);
+    if (size > 0) {
+        /* The document was truncated after the Content-Length was written */
+        wp->flags &= ~WEBS_KEEP_ALIVE;
+    }
+    websDone(wp);
+}
+
+
 /*
     Do output back to the browser in the background. This is a socket write handler.
-    This bypasses the output buffer and writes directly to the socket.
+    Document data is read into the free space of the output buffer and written from there, so no intermediate buffer
+    is required.
  */
 static void fileWriteEvent(Webs *wp)
 {
-    char    *buf;
-    ssize   len, wrote;
-    int     err;
+    WebsBuf     *op;
+    ssize       len, room;
 
     assert(wp);
     assert(websValid(wp));
 
-    if ((buf = walloc(ME_GOAHEAD_LIMIT_BUFFER)) == NULL) {
-        websError(wp, HTTP_CODE_INTERNAL_SERVER_ERROR, "Cannot get memory");
+#if LINUX && !ME_ROM && !__UCLIBC__
+    if (!(wp->flags & WEBS_SECURE)) {
+        sendFileData(wp);
         return;
     }
-    while ((len = websPageReadData(wp, buf, ME_GOAHEAD_LIMIT_BUFFER)) > 0) {
-        if ((wrote = websWriteSocket(wp, buf, len)) < 0) {
-            err = socketGetError(wp->sid);
-            if (err == EWOULDBLOCK || err == EAGAIN) {
-                websPageSeek(wp, -len, SEEK_CUR);
-            } else {
-                /* Will call websDone below */
-                wp->state = WEBS_COMPLETE;
-            }
-            break;
+#endif
+    op = &wp->output;
+    do {
+        len = 0;
+        if ((room = bufRoom(op)) > 0 && (len = websPageReadData(wp, (char*) op->endp, room)) > 0) {
+            bufAdjustEnd(op, len);
+            bufAddNull(op);
         }
-        if (wrote != len) {
-            websPageSeek(wp, - (len - wrote), SEEK_CUR);
+        if (websFlush(wp, 0) < 0) {
             break;
         }
+        if (len > 0 && bufLen(op) == 0 && op->buflen < ME_GOAHEAD_LIMIT_BUFFER_MAX) {
+            /* The socket is keeping up, so read and write in larger blocks */
+            bufGrow(op, min(op->buflen, ME_GOAHEAD_LIMIT_BUFFER_MAX - op->buflen));
+        }
+    } while (len > 0 && bufLen(op) == 0 && wp->state < WEBS_COMPLETE);
+
+    if (len <= 0 && room > 0) {
+        websDone(wp);
     }
-    wfree(buf);
-    if (len <= 0) {
+}
+
+
+#if LINUX && !ME_ROM && !__UCLIBC__
+/*
+    Send the document directly from the file to the socket. This avoids copying the data through a user buffer and
+    the read, write and seek system calls for each block.
+ */
+static void sendFileData(Webs *wp)
+{
+    WebsSocket  *sp;
+    ssize       wrote;
+
+    if ((wp->flags & WEBS_CLOSED) || (sp = socketPtr(wp->sid)) == NULL) {
         websDone(wp);
+        return;
+    }
+    while ((wrote = sendfile(sp->sock, wp->docfd, NULL, FILE_SEND_SIZE)) > 0) {
+        /* Sendfile pushes any headers held back by a corked write */
+        sp->flags &= ~SOCKET_CORKED;
+        wp->written += wrote;
+        websNoteRequestActivity(wp);
     }
+    if (wrote < 0) {
+        if (errno == EINTR || errno == EWOULDBLOCK || errno == EAGAIN) {
+            /* Wait for the socket to become writable */
+            return;
+        }
+        /* Will call websDone below */
+        wp->state = WEBS_COMPLETE;
+    }
+    websDone(wp);
 }
+#endif
 
 
 #if !ME_ROM
@@ -10,6 +10,7 @@
         --route routeFile      # Route configuration file
         --verbose              # Same as --log stdout:2
         --version              # Output version information
+        --workers count        # Number of worker processes
 
     Copyright (c) All Rights Reserved. See details at the end of the file.
  */
@@ -43,7 +44,7 @@ static void sigHandler(int signo);
 MAIN(goahead, int argc, char **argv, char **envp)
 {
     char    *argp, *home, *documents, *endpoints, *endpoint, *route, *auth, *tok, *lspec;
-    int     argind;
+    int     argind, rc;
 
 #if WINDOWS
     if (windowsInit() < 0) {
@@ -91,6 +92,12 @@ MAIN(goahead, int argc, char **argv, char **envp)
             printf("%s\n", ME_VERSION);
             exit(0);
 
+#if ME_UNIX_LIKE
+        } else if (smatch(argp, "--workers") || smatch(argp, "-w")) {
+            if (argind >= argc) usage();
+            websSetWorkers(atoi(argv[++argind]));
+#endif
+
         } else if (*argp == '-' && isdigit((uchar) argp[1])) {
             lspec = sfmt("stdout:%s", &argp[1]);
             logSetPath(lspec);
@@ -166,6 +173,15 @@ MAIN(goahead, int argc, char **argv, char **envp)
             return -1;
         }
     }
+#endif
+#if ME_UNIX_LIKE
+    /*
+        In worker mode, the master supervises the workers till terminated
+     */
+    if ((rc = websStartWorkers(&finished)) != 0) {
+        websClose();
+        return rc < 0 ? -1 : 0;
+    }
 #endif
     websServiceEvents(&finished);
     logmsg(1, "Instructed to exit");
@@ -211,7 +227,11 @@ static void usage() {
         "    --log logFile:level    # Log to file file at verbosity level\n"
         "    --route routeFile      # Route configuration file\n"
         "    --verbose              # Same as --log stdout:2\n"
-        "    --version              # Output version information\n\n",
+        "    --version              # Output version information\n"
+#if ME_UNIX_LIKE
+        "    --workers count        # Number of worker processes\n"
+#endif
+        "\n",
         ME_TITLE, ME_NAME);
     exit(-1);
 }
@@ -34,6 +34,33 @@ extern "C" {
 #ifndef ME_GOAHEAD_TRACING
     #define ME_GOAHEAD_TRACING 1                /**< Default for tracing "on" */
 #endif
+#ifndef ME_GOAHEAD_EPOLL
+    #define ME_GOAHEAD_EPOLL LINUX              /**< Default to epoll for socket events on Linux */
+#endif
+#ifndef ME_GOAHEAD_ACTION_THREADS
+    #define ME_GOAHEAD_ACTION_THREADS 4         /**< Worker threads for asynchronous actions */
+#endif
+#ifndef ME_GOAHEAD_STATS
+    #define ME_GOAHEAD_STATS 1                  /**< Default to collecting event loop statistics */
+#endif
+#ifndef ME_GOAHEAD_WORKERS
+    #define ME_GOAHEAD_WORKERS 0                /**< Default to a single server process */
+#endif
+#ifndef ME_GOAHEAD_CORK
+    #define ME_GOAHEAD_CORK 0                   /**< Default to sending partial response segments immediately */
+#endif
+#ifndef ME_GOAHEAD_LIMIT_ACCEPT
+    #define ME_GOAHEAD_LIMIT_ACCEPT 16          /**< Maximum connections to accept per listen event */
+#endif
+#ifndef ME_GOAHEAD_LIMIT_OUTPUT
+    #define ME_GOAHEAD_LIMIT_OUTPUT 262144      /**< Maximum buffered response data per connection */
+#endif
+#ifndef ME_GOAHEAD_LIMIT_BUFFER_MAX
+    #define ME_GOAHEAD_LIMIT_BUFFER_MAX 65536   /**< Maximum size active connection buffers may grow to */
+#endif
+#ifndef ME_GOAHEAD_LIMIT_POOL
+    #define ME_GOAHEAD_LIMIT_POOL 16            /**< Maximum idle connection objects retained for reuse */
+#endif
 #ifndef ME_GOAHEAD_DEBUG
     #if ME_DEBUG
         #define ME_GOAHEAD_DEBUG 1              /**< Debug logging on in debug builds by default */
@@ -791,6 +818,16 @@ PUBLIC int wopenAlloc(void *buf, int bufsize, int flags);
  */
 PUBLIC void *walloc(ssize size);
 
+/**
+    Get the number of memory allocations
+    @description This counts calls to walloc and wrealloc since the server started. Take the difference of two calls
+        to measure the allocations made by an operation.
+    @return Count of allocations
+    @ingroup WebsAlloc
+    @stability Prototype
+ */
+PUBLIC int64 wallocCount();
+
 /**
     Free an allocated block of memory
     @param blk Reference to the memory block to free.
@@ -846,6 +883,94 @@ PUBLIC wchar *amtow(char *src, ssize *len);
 PUBLIC char  *awtom(wchar *src, ssize *len);
 #endif
 
+/********************************** Arena ***********************************/
+/**
+    Arena allocator
+    @description An arena is a bump allocator for short lived memory that is released in one operation by arenaReset.
+        Each request uses an arena for its string fields and variable values. Memory allocated from an arena must
+        not be freed via wfree.
+    @see arenaAlloc arenaClone arenaCreate arenaFmt arenaFree arenaReset
+    @defgroup WebsArena WebsArena
+    @stability Prototype
+ */
+typedef struct WebsArena {
+    char    *buf;               /**< Primary block. Retained over resets */
+    char    *next;              /**< Next free byte in the current block */
+    char    *end;               /**< End of the current block */
+    void    *blocks;            /**< Overflow blocks allocated since the last reset */
+    ssize   size;               /**< Size of the primary block */
+    ssize   used;               /**< Total bytes allocated since the last reset */
+} WebsArena;
+
+/**
+    Allocate memory from an arena
+    @param ap Arena reference
+    @param size Size of memory to allocate
+    @return Reference to the memory or null if the memory cannot be allocated. The memory is not zeroed.
+    @ingroup WebsArena
+    @stability Prototype
+ */
+PUBLIC void *arenaAlloc(WebsArena *ap, ssize size);
+
+/**
+    Clone a string into an arena
+    @param ap Arena reference
+    @param str String to clone. If null, an empty string is returned.
+    @return Arena allocated copy of the string
+    @ingroup WebsArena
+    @stability Prototype
+ */
+PUBLIC char *arenaClone(WebsArena *ap, cchar *str);
+
+/**
+    Create an arena
+    @param ap Arena reference
+    @param size Size of the primary arena block. Set to zero for a default size.
+    @return Zero if successful
+    @ingroup WebsArena
+    @stability Prototype
+ */
+PUBLIC int arenaCreate(WebsArena *ap, ssize size);
+
+/**
+    Format a string into an arena
+    @param ap Arena reference
+    @param format Printf style format string
+    @param ... Arguments for the format string
+    @return Arena allocated formatted string
+    @ingroup WebsArena
+    @stability Prototype
+ */
+PUBLIC char *arenaFmt(WebsArena *ap, cchar *format, ...) PRINTF_ATTRIBUTE(2,3);
+
+/**
+    Format a string into an arena using a va_list
+    @param ap Arena reference
+    @param format Printf style format string
+    @param args Varargs argument list
+    @return Arena allocated formatted string
+    @ingroup WebsArena
+    @stability Prototype
+ */
+PUBLIC char *arenaFmtv(WebsArena *ap, cchar *format, va_list args);
+
+/**
+    Free an arena and all its memory
+    @param ap Arena reference
+    @ingroup WebsArena
+    @stability Prototype
+ */
+PUBLIC void arenaFree(WebsArena *ap);
+
+/**
+    Release all allocations from an arena
+    @description The primary block is retained for reuse.
+    @param ap Arena reference
+    @ingroup WebsArena
+    @stability Prototype
+ */
+PUBLIC void arenaReset(WebsArena *ap);
+
 /******************************* Hash Table *********************************/
 /**
     Hash table entry structure.
@@ -877,6 +1002,15 @@ typedef int WebsHash;                       /* Returned by symCreate */
  */
 PUBLIC WebsHash hashCreate(int size);
 
+/**
+    Remove all entries from a hash table
+    @description The hash table itself and its index are retained so the table can be reused without reallocation.
+    @param id Hash table id returned by hashCreate
+    @ingroup WebsHash
+    @stability Prototype
+ */
+PUBLIC void hashClear(WebsHash id);
+
 /**
     Free a hash table
     @param id Hash table id returned by hashCreate
@@ -962,6 +1096,10 @@ PUBLIC WebsKey *hashNext(WebsHash id, WebsKey *last);
 #define SOCKET_BUFFERED_READ    0x200   /**< Message pending on this socket */
 #define SOCKET_BUFFERED_WRITE   0x400   /**< Message pending on this socket */
 #define SOCKET_NODELAY          0x800   /**< Disable Nagle algorithm */
+#define SOCKET_REUSEPORT        0x1000  /**< Permit multiple listeners on the same endpoint */
+#define SOCKET_CORK             0x2000  /**< Coalesce partial writes with the data that follows */
+#define SOCKET_CORKED           0x4000  /**< Data held back by a corked write is pending */
+#define SOCKET_NOLISTEN         0x8000  /**< Only bind the endpoint to verify it is available */
 
 #define SOCKET_PORT_MAX         0xffff  /**< Max Port size */
 
@@ -1023,6 +1161,7 @@ typedef struct WebsSocket {
     SocketAccept    accept;             /**< Accept handler */
     SocketHandler   handler;            /**< User I/O handler */
     char            *ip;                /**< Server listen address or remote client address */
+    char            *ifaddr;            /**< Local interface address for listeners bound to a specific address */
     void            *handler_data;      /**< User handler data */
     int             handlerMask;        /**< Handler events of interest */
     int             sid;                /**< Index into socket[] */
@@ -1039,6 +1178,21 @@ typedef struct WebsSocket {
     int             handshakes;         /**< Number of renegotiations */
 } WebsSocket;
 
+/**
+    I/O vector element for socketWriteVector and websWriteSocketVector
+    @ingroup WebsSocket
+    @stability Prototype
+ */
+typedef struct WebsIOVec {
+    char            *start;             /**< Start of the data */
+    ssize           len;                /**< Length of the data */
+} WebsIOVec;
+
+/**
+    Maximum number of elements for socketWriteVector
+ */
+#define WEBS_MAX_IOVEC 8
+
 
 /**
     Extract the numerical IP address and port for the given socket info
@@ -1238,8 +1392,10 @@ PUBLIC bool socketIsV6(int sid);
     @param host Host IP address on which to listen. Set to NULL to listen on all interfaces.
     @param port TCP/IP port on which to listen
     @param accept SocketAccept callback function to invoke to receive incoming connections.
-    @param flags Reserved
-    @return Zero if successful, otherwise -1.
+    @param flags Set to SOCKET_REUSEPORT to share the endpoint with other listeners and SOCKET_CORK to coalesce
+        partial writes on accepted connections. Set SOCKET_NOLISTEN to bind the endpoint and close it again without
+        listening. This verifies the endpoint is available without queuing any connections.
+    @return Socket ID if successful, otherwise -1. With SOCKET_NOLISTEN, zero is returned if successful.
     @ingroup WebsSocket
     @stability Stable
  */
@@ -1335,6 +1491,39 @@ PUBLIC int socketSelect(int sid, int timeout);
  */
 PUBLIC int socketSetBlock(int sid, int on);
 
+/**
+    Allocate a socket object for an existing descriptor
+    @description This permits descriptors such as pipes to be serviced by the socket event loop. Define a handler via
+        socketCreateHandler. The descriptor is closed when the socket object is freed via socketFree.
+    @param fd Descriptor
+    @return Socket ID or -1 if the object cannot be allocated.
+    @ingroup WebsSocket
+    @stability Prototype
+ */
+PUBLIC int socketAllocFd(Socket fd);
+
+/**
+    Recreate the socket event mechanism after a fork
+    @description A child process that services sockets after fork must call this so it does not share the
+        parent's event descriptor. Existing sockets are re-registered.
+    @return Zero if successful, otherwise -1.
+    @ingroup WebsSocket
+    @stability Prototype
+ */
+PUBLIC int socketReopenEvents();
+
+/**
+    Get socket handler statistics
+    @description Socket handler callbacks are timed when ME_GOAHEAD_STATS is enabled.
+    @param count Set to the number of handler callbacks
+    @param elapsed Set to the total time spent in handler callbacks in microseconds
+    @param worst Set to the duration of the longest handler callback in microseconds
+    @param reset If true, reset the statistics after returning them
+    @ingroup WebsSocket
+    @stability Prototype
+ */
+PUBLIC void socketGetHandlerStats(int64 *count, int64 *elapsed, int64 *worst, int reset);
+
 /**
     Set the error code for the last socket operation on this thread.
     @param error Integer error code. See errno or GetLastError() on windows.
@@ -1354,6 +1543,28 @@ PUBLIC void socketSetError(int error);
  */
 PUBLIC int socketSetNoDelay(int sid, bool on);
 
+/**
+    Set the socket cork mode
+    @description When enabled, writes that are followed by more data are sent with MSG_MORE so the kernel can
+        coalesce them into full TCP segments. The held data is sent by the next write without more data following
+        or by socketPush. Set on a listening socket to apply to all accepted connections. This is only supported on
+        Linux and is ignored elsewhere.
+    @param sid Socket ID handle returned from socketConnect, socketAccept or socketListen.
+    @param on Set to 1 to enable coalescing
+    @return The previous cork mode
+    @ingroup WebsSocket
+    @stability Prototype
+ */
+PUBLIC int socketSetCork(int sid, bool on);
+
+/**
+    Push data held back by a corked write
+    @param sid Socket ID handle returned from socketConnect or socketAccept.
+    @ingroup WebsSocket
+    @stability Prototype
+ */
+PUBLIC void socketPush(int sid);
+
 /**
     Wait for a socket I/O event
     @param sp Socket object
@@ -1377,6 +1588,22 @@ PUBLIC int socketWaitForEvent(WebsSocket *sp, int mask);
  */
 PUBLIC ssize socketWrite(int sid, void *buf, ssize len);
 
+/**
+    Write a vector of data blocks to the socket
+    @description The blocks are written in order with a single system call where the O/S supports gathered writes.
+    @param sid Socket ID handle returned from socketConnect or socketAccept.
+    @param iov Array of data blocks to write
+    @param count Number of elements in iov. Must not exceed WEBS_MAX_IOVEC.
+    @param more Set to true if more data will follow. If the socket is corked, a trailing partial segment is held
+        back to be coalesced with that data. See socketSetCork.
+    @return Count of bytes written. May be less than the total length if the socket is in non-blocking mode.
+        Returns a negative error code for errors. If the transport is saturated, errno will be set to EAGAIN or
+        EWOULDBLOCK.
+    @ingroup WebsSocket
+    @stability Prototype
+ */
+PUBLIC ssize socketWriteVector(int sid, WebsIOVec *iov, int count, bool more);
+
 /**
     Return the socket object for the socket ID.
     @param sid Socket ID handle returned from socketConnect or socketAccept.
@@ -1393,7 +1620,7 @@ PUBLIC WebsSocket *socketPtr(int sid);
     @description GoAhead provides a secure runtime environment for safe string manipulation and to
         help prevent buffer overflows and other potential security traps.
     @defgroup WebsRuntime WebsRuntime
-    @see fmt wallocHandle wallocObject wfreeHandle hextoi itosbuf scaselesscmp scaselessmatch
+    @see fmt fmtv wallocHandle wallocObject wfreeHandle hextoi itosbuf scaselesscmp scaselessmatch
         sclone scmp scopy sfmt sfmtv slen slower smatch sstarts sncaselesscmp sncmp sncopy stok strim supper
     @stability Stable
  */
@@ -1412,6 +1639,20 @@ PUBLIC WebsSocket *socketPtr(int sid);
  */
 PUBLIC char *fmt(char *buf, ssize maxSize, cchar *format, ...);
 
+/**
+    Format a string into a static buffer using a va_list.
+    @description This call format a string using printf style formatting arguments. A trailing null will
+        always be appended. If the result does not fit, it is truncated to maxSize - 1 characters.
+    @param buf Pointer to the buffer.
+    @param maxSize Size of the buffer.
+    @param format Printf style format string
+    @param args Varargs argument obtained from va_start.
+    @return Returns the buffer.
+    @ingroup WebsRuntime
+    @stability Prototype
+ */
+PUBLIC char *fmtv(char *buf, ssize maxSize, cchar *format, va_list args);
+
 /**
     Allocate a handle from a map
     @param map Reference to a location holding the map reference. On the first call, the map is allocated.
@@ -1757,11 +1998,31 @@ PUBLIC void websRestartEvent(int id, int delay);
 /**
     Run due events
     @ingroup WebsRuntime
-    @return Time delay till the next event
+    @return Time delay in milliseconds till the next event
     @internal
  */
 PUBLIC int websRunEvents();
 
+/**
+    Get the current tick count
+    @description The tick count is a monotonic time in milliseconds. It is not related to the time of day and
+        should only be used to measure intervals.
+    @return Time in milliseconds
+    @ingroup WebsRuntime
+    @stability Evolving
+ */
+PUBLIC int64 websGetTicks();
+
+/**
+    Get the current high resolution tick count
+    @description The tick count is a monotonic time in microseconds. It is not related to the time of day and
+        should only be used to measure short intervals.
+    @return Time in microseconds
+    @ingroup WebsRuntime
+    @stability Prototype
+ */
+PUBLIC int64 websGetHiResTicks();
+
 /* Forward declare */
 struct WebsRoute;
 struct WebsUser;
@@ -1841,6 +2102,9 @@ PUBLIC WebsUpload *websLookupUpload(struct Webs *wp, cchar *key);
 #define WEBS_SECURE             0x1000      /**< Connection uses SSL */
 #define WEBS_UPLOAD             0x2000      /**< Multipart-mime file upload */
 #define WEBS_VARS_ADDED         0x4000      /**< Query and body form vars added */
+#define WEBS_ASYNC              0x10000     /**< Running an asynchronous action */
+#define WEBS_NONBLOCK           0x20000     /**< Handler can resume after short writes */
+#define WEBS_HEADER_VARS        0x40000     /**< HTTP_* header vars added */
 #if ME_GOAHEAD_LEGACY
 #define WEBS_LOCAL              0x8000      /**< Request from local system */
 #endif
@@ -1880,109 +2144,205 @@ PUBLIC WebsUpload *websLookupUpload(struct Webs *wp, cchar *key);
  */
 typedef void (*WebsWriteProc)(struct Webs *wp);
 
+/*
+    Known request header ids. See websGetHeaderId.
+ */
+#define WEBS_HDR_OTHER              0   /**< Header that is not specially handled */
+#define WEBS_HDR_AUTHORIZATION      1   /**< Authorization */
+#define WEBS_HDR_CONNECTION         2   /**< Connection */
+#define WEBS_HDR_CONTENT_LENGTH     3   /**< Content-Length */
+#define WEBS_HDR_CONTENT_TYPE       4   /**< Content-Type */
+#define WEBS_HDR_COOKIE             5   /**< Cookie */
+#define WEBS_HDR_HOST               6   /**< Host */
+#define WEBS_HDR_IF_MODIFIED_SINCE  7   /**< If-Modified-Since */
+#define WEBS_HDR_REFERER            8   /**< Referer */
+#define WEBS_HDR_TRANSFER_ENCODING  9   /**< Transfer-Encoding */
+#define WEBS_HDR_USER_AGENT         10  /**< User-Agent */
+
+/**
+    Request header slice
+    @description Each request header is recorded as a key and value slice of the Webs.rxHeaders block. The key is
+        lower case. Both the key and value are null terminated.
+    @ingroup Webs
+    @stability Prototype
+ */
+typedef struct WebsHeader {
+    int             id;                 /**< Known header id (WEBS_HDR_*) */
+    int             key;                /**< Offset of the header key in rxHeaders */
+    int             keyLen;             /**< Length of the header key */
+    int             value;              /**< Offset of the header value in rxHeaders */
+    int             valueLen;           /**< Length of the header value */
+} WebsHeader;
+
+#if ME_GOAHEAD_DIGEST
+/**
+    Digest authentication state
+    @description Parsed fields of a digest Authorization header. Allocated from the request arena when a digest
+        header is parsed.
+    @ingroup Webs
+    @stability Prototype
+ */
+typedef struct WebsDigestState {
+    char            *cnonce;            /**< check nonce */
+    char            *digestUri;         /**< URI found in digest header */
+    char            *nonce;             /**< opaque-to-client string sent by server */
+    char            *nc;                /**< nonce count */
+    char            *opaque;            /**< opaque value passed from server */
+    char            *qop;               /**< quality operator */
+} WebsDigestState;
+#endif
+
+#if ME_GOAHEAD_UPLOAD
+/**
+    Multipart upload state
+    @description Allocated from the request arena when a multipart upload request is started.
+    @ingroup Webs
+    @stability Prototype
+ */
+typedef struct WebsUploadState {
+    char            *boundary;          /**< Mime boundary (static) */
+    ssize           boundaryLen;        /**< Boundary length */
+    WebsUpload      *currentFile;       /**< Current file context */
+    char            *clientFilename;    /**< Current file filename */
+    char            *tmp;               /**< Current temp filename for upload data */
+    char            *var;               /**< Current upload form variable name */
+    int             fd;                 /**< Upload file handle */
+    int             state;              /**< Current file upload state */
+} WebsUploadState;
+#endif
+
+#if ME_GOAHEAD_CGI
+/**
+    CGI request state
+    @description Allocated from the request arena when a CGI request is started.
+    @ingroup Webs
+    @stability Prototype
+ */
+typedef struct WebsCgiState {
+    char            *stdIn;             /**< Filename for CGI program input */
+    int             fd;                 /**< File handle for CGI program input */
+} WebsCgiState;
+#endif
+
+#if ME_GOAHEAD_JAVASCRIPT
+/**
+    JavaScript template page state
+    @description Allocated from the request arena when a JST page is rendered. Rendering is suspended between
+        scripts while the client is not accepting the response.
+    @ingroup Webs
+    @stability Prototype
+ */
+typedef struct WebsJstState {
+    char            *page;              /**< Page text. Scripts are terminated in place as they are evaluated */
+    char            *next;              /**< Next page text to render */
+    int             jid;                /**< JavaScript engine */
+} WebsJstState;
+#endif
+
 /**
     GoAhead request structure. This is a per-socket connection structure.
+    @description Fields used on every I/O event and request are grouped at the front of the structure. State for
+        less common features (digest authentication, upload and CGI) is kept in side structures that are allocated
+        from the request arena on first use.
     @defgroup Webs Webs
  */
 typedef struct Webs {
+    int             state;              /**< Current state */
+    int             flags;              /**< Current flags -- see above */
+    int             sid;                /**< Socket id (handler) */
+    int             wid;                /**< Index into webs */
+    int             code;               /**< Response status code */
+    int             timeout;            /**< Timeout handle */
+    int             docfd;              /**< File descriptor for document being served */
+    int             rxChunkState;       /**< Rx chunk encoding state */
+    int             txChunkState;       /**< Transmit chunk state */
+    int             rxHeaderCount;      /**< Number of request headers */
+    WebsHash        vars;               /**< Request variables. Created on first use, -1 until then */
+    int             finalized: 1;          /**< Request has been completed */
+    int             error: 1;              /**< Request has an error */
+    int             connError: 1;          /**< Request has a connection error */
+    bool            eof;                /**< If at the end of the request content */
+
     WebsBuf         rxbuf;              /**< Raw receive buffer */
     WebsBuf         input;              /**< Receive buffer after de-chunking */
-    WebsBuf         output;             /**< Transmit buffer after chunking */
-    WebsBuf         chunkbuf;           /**< Pre-chunking data buffer */
+    WebsBuf         output;             /**< Transmit buffer. Chunk data is framed in place */
     WebsBuf         *txbuf;
-    WebsTime        since;              /**< Parsed if-modified-since time */
+    WebsWriteProc   writeData;          /**< Handler write I/O event callback. Used by fileHandler */
+    struct WebsRoute *route;            /**< Request route */
+    void            *ssl;               /**< SSL context */
     WebsTime        timestamp;          /**< Last transaction with browser */
-    WebsHash        vars;               /**< CGI standard variables */
-    int             timeout;            /**< Timeout handle */
-    char            ipaddr[ME_MAX_IP];  /**< Connecting ipaddress */
-    char            ifaddr[ME_MAX_IP];  /**< Local interface ipaddress */
 
-    int             rxChunkState;       /**< Rx chunk encoding state */
+    ssize           rxLen;              /**< Rx content length */
+    ssize           rxRemaining;        /**< Remaining content to read from client */
     ssize           rxChunkSize;        /**< Rx chunk size */
     char            *rxEndp;            /**< Pointer to end of raw data in input beyond endp */
+    ssize           rxScanned;          /**< Bytes of rxbuf searched for the end of the request header */
     ssize           lastRead;           /**< Number of bytes last read from the socket */
-    bool            eof;                /**< If at the end of the request content */
-
-    char            txChunkPrefix[16];  /**< Transmit chunk prefix */
-    char            *txChunkPrefixNext; /**< Current I/O pos in txChunkPrefix */
-    ssize           txChunkPrefixLen;   /**< Length of prefix */
-    ssize           txChunkLen;         /**< Length of the chunk */
-    int             txChunkState;       /**< Transmit chunk state */
-
-    char            *authDetails;       /**< Http header auth details */
-    char            *authResponse;      /**< Outgoing auth header */
-    char            *authType;          /**< Authorization type (Basic/DAA) */
-    char            *contentType;       /**< Body content type */
-    char            *cookie;            /**< Request cookie string */
-    char            *decodedQuery;      /**< Decoded request query */
-    char            *digest;            /**< Password digest */
-    char            *ext;               /**< Path extension */
-    char            *filename;          /**< Document path name */
-    char            *host;              /**< Requested host */
+    ssize           txLen;              /**< Tx content length header value */
+    ssize           written;            /**< Bytes actually transferred */
+    ssize           txBufSize;          /**< Output buffer size suited to recent responses on this connection */
+    ssize           txChunkStart;       /**< Offset in output of the prefix of the open transmit chunk */
+    char            *txBlock;           /**< Block transferred by websTransferBlock. Written after output */
+    char            *txBlockNext;       /**< Current I/O pos in txBlock */
+    ssize           txBlockLen;         /**< Remaining length of txBlock to write */
+
+    WebsArena       arena;              /**< Arena for request strings and var values. Reset when the request ends */
+    char            *rxHeaders;         /**< Copy of the request header block in the arena */
+    WebsHeader      *rxHeaderList;      /**< Request header slices */
     char            *method;            /**< HTTP request method */
-    char            *password;          /**< Authorization password */
+    char            *url;               /**< Full request url. This is not decoded. */
     char            *path;              /**< Path name without query. This is decoded. */
-    char            *protoVersion;      /**< Protocol version (HTTP/1.1)*/
-    char            *protocol;          /**< Protocol scheme (normally http|https) */
-    char            *putname;           /**< PUT temporary filename */
     char            *query;             /**< Request query. This is decoded. */
-    char            *realm;             /**< Realm field supplied in auth header */
+    char            *decodedQuery;      /**< Decoded request query */
+    char            *protocol;          /**< Protocol scheme (normally http|https) */
+    char            *protoVersion;      /**< Protocol version (HTTP/1.1)*/
+    char            *host;              /**< Requested host */
+    char            *filename;          /**< Document path name */
+    char            *ext;               /**< Path extension */
+    char            *contentType;       /**< Body content type */
+    char            *cookie;            /**< Request cookie string */
+    char            *userAgent;         /**< User agent (browser) */
     char            *referrer;          /**< The referring page */
     char            *responseCookie;    /**< Outgoing cookie */
-    char            *url;               /**< Full request url. This is not decoded. */
-    char            *userAgent;         /**< User agent (browser) */
-    char            *username;          /**< Authorization username */
-    int             sid;                /**< Socket id (handler) */
+
+    /*
+        Colder fields follow
+     */
     int             listenSid;          /**< Listen Socket id */
     int             port;               /**< Request port number */
-    int             state;              /**< Current state */
-    int             flags;              /**< Current flags -- see above */
-    int             code;               /**< Response status code */
     int             routeCount;         /**< Route count limiter */
-    ssize           rxLen;              /**< Rx content length */
-    ssize           rxRemaining;        /**< Remaining content to read from client */
-    ssize           txLen;              /**< Tx content length header value */
-    int             wid;                /**< Index into webs */
-#if ME_GOAHEAD_CGI
-    char            *cgiStdin;          /**< Filename for CGI program input */
-    int             cgifd;              /**< File handle for CGI program input */
-#endif
-#if !ME_ROM
-    int             putfd;              /**< File handle to write PUT data */
-#endif
-    int             docfd;              /**< File descriptor for document being served */
-    ssize           written;            /**< Bytes actually transferred */
-    ssize           putLen;             /**< Bytes read by a PUT request */
-
-    int             finalized: 1;          /**< Request has been completed */
-    int             error: 1;              /**< Request has an error */
-    int             connError: 1;          /**< Request has a connection error */
-
+    int             encoded;            /**< True if the password is MD5(username:realm:password) */
+    WebsTime        since;              /**< Parsed if-modified-since time */
+    int64           allocs;             /**< Allocation count when the request started. See wallocCount */
     struct WebsSession *session;        /**< Session record */
-    struct WebsRoute *route;            /**< Request route */
     struct WebsUser *user;              /**< User auth record */
-    WebsWriteProc   writeData;          /**< Handler write I/O event callback. Used by fileHandler */
-    int             encoded;            /**< True if the password is MD5(username:realm:password) */
-#if ME_GOAHEAD_DIGEST
-    char            *cnonce;            /**< check nonce */
-    char            *digestUri;         /**< URI found in digest header */
-    char            *nonce;             /**< opaque-to-client string sent by server */
-    char            *nc;                /**< nonce count */
-    char            *opaque;            /**< opaque value passed from server */
-    char            *qop;               /**< quality operator */
+    char            *authDetails;       /**< Http header auth details */
+    char            *authResponse;      /**< Outgoing auth header */
+    char            *authType;          /**< Authorization type (Basic/DAA) */
+    char            *digest;            /**< Password digest */
+    char            *password;          /**< Authorization password */
+    char            *realm;             /**< Realm field supplied in auth header */
+    char            *username;          /**< Authorization username */
+#if !ME_ROM
+    char            *putname;           /**< PUT temporary filename */
+    ssize           putLen;             /**< Bytes read by a PUT request */
+    int             putfd;              /**< File handle to write PUT data */
 #endif
 #if ME_GOAHEAD_UPLOAD
-    int             upfd;               /**< Upload file handle */
     WebsHash        files;              /**< Uploaded files */
-    char            *boundary;          /**< Mime boundary (static) */
-    ssize           boundaryLen;        /**< Boundary length */
-    int             uploadState;        /**< Current file upload state */
-    WebsUpload      *currentFile;       /**< Current file context */
-    char            *clientFilename;    /**< Current file filename */
-    char            *uploadTmp;         /**< Current temp filename for upload data */
-    char            *uploadVar;         /**< Current upload form variable name */
+    WebsUploadState *uploadState;       /**< Upload state. Null until an upload is started */
 #endif
-    void            *ssl;               /**< SSL context */
+#if ME_GOAHEAD_DIGEST
+    WebsDigestState *digestState;       /**< Digest authentication state. Null until a digest header is parsed */
+#endif
+#if ME_GOAHEAD_CGI
+    WebsCgiState    *cgiState;          /**< CGI state. Null until a CGI request is started */
+#endif
+#if ME_GOAHEAD_JAVASCRIPT
+    WebsJstState    *jstState;          /**< JST page state. Null unless a JST page is being rendered */
+#endif
+    char            ipaddr[ME_MAX_IP];  /**< Connecting ipaddress */
+    char            ifaddr[ME_MAX_IP];  /**< Local interface ipaddress */
 } Webs;
 
 #if ME_GOAHEAD_LEGACY
@@ -2028,6 +2388,42 @@ typedef struct WebsHandler {
  */
 typedef void (*WebsAction)(Webs *wp);
 
+/**
+    Asynchronous action request
+    @description Private copy of the request inputs made on the event loop thread before an asynchronous action
+        runs. The vars are the request variables: query and form vars and the HTTP_* header vars. Read them with
+        websGetAsyncVar.
+    @ingroup Webs
+    @stability Prototype
+ */
+typedef struct WebsAsync {
+    char    *method;                    /**< HTTP request method */
+    char    *path;                      /**< Path portion of the request URI */
+    char    *query;                     /**< Request query. Decoded request vars are in vars */
+    char    **vars;                     /**< Request variable names and values in pairs, terminated by NULL */
+} WebsAsync;
+
+/**
+    Asynchronous action callback
+    @description This runs on an action worker thread. It must read the request only via the WebsAsync copy.
+    @param async Copy of the request inputs. This is freed after the completion callback returns.
+    @return An allocated result to pass to the completion callback. May be NULL.
+    @ingroup Webs
+    @stability Prototype
+ */
+typedef char *(*WebsAsyncAction)(WebsAsync *async);
+
+/**
+    Asynchronous action completion callback
+    @description This runs on the event loop thread after the WebsAsyncAction callback returns. It should write the
+        response and call websDone.
+    @param wp Webs request object
+    @param result Result returned by the WebsAsyncAction callback. This is freed after the callback returns.
+    @ingroup Webs
+    @stability Prototype
+ */
+typedef void (*WebsAsyncDone)(Webs *wp, char *result);
+
 #if ME_GOAHEAD_LEGACY
     typedef void (*WebsProc)(Webs *wp, char *path, char *query);
 #endif
@@ -2311,6 +2707,7 @@ PUBLIC void websFileOpen();
     @description This call initiates sending buffered data. If blocking mode is selected via the block parameter,
         this call will wait until all the data has been sent to the O/S for transmission to the client.
         If block is false, the flush will be initiated and the call will return immediately without blocking.
+        Data held back on a corked socket is pushed to the client.
     @param wp Webs request object
     @param block Set to true to wait for all data to be written to the socket. Set to false to
         write whatever the socket can absorb without blocking.
@@ -2358,6 +2755,16 @@ PUBLIC char *websGetCgiCommName();
  */
 PUBLIC cchar *websGetCookie(Webs *wp);
 
+/**
+    Get the current date as a string
+    @description The string is cached and rendered at most once per second. It is used for the Date response
+        header and is in the same format as websGetDateString.
+    @return The current date string. Caller must not free. The string is updated in place when the time changes.
+    @ingroup Webs
+    @stability Prototype
+ */
+PUBLIC cchar *websGetDate();
+
 /**
     Get a date as a string
     @description If sbuf is supplied, it is used to calculate the date. Otherwise, the current time is used.
@@ -2425,6 +2832,17 @@ PUBLIC cchar *websGetExt(Webs *wp);
  */
 PUBLIC cchar *websGetFilename(Webs *wp);
 
+/**
+    Get the known header id for a request header key
+    @description This maps a header key to a WEBS_HDR_* id with a single switch on the key length and first character.
+    @param key Header key in lower case. Need not be null terminated.
+    @param len Length of the key
+    @return The WEBS_HDR_* id or WEBS_HDR_OTHER if the header is not specially handled.
+    @ingroup Webs
+    @stability Prototype
+ */
+PUBLIC int websGetHeaderId(cchar *key, ssize len);
+
 /**
     Get the request host
     @description The request host is set to the Host HTTP header value if it is present. Otherwise it is set to
@@ -2592,7 +3010,8 @@ PUBLIC cchar *websGetVar(Webs *wp, cchar *name, cchar *defaultValue);
     @description The URI is mapped to a filename by decoding and prepending with the request directory.
         For IPv6 addresses, use the format: [aaaa:bbbb:cccc:dddd:eeee:ffff:gggg:hhhh:iiii]:port.
     @param endpoint IPv4 or IPv6 address on which to listen.
-    @return Positive integer holding a Socket ID handle if successful, otherwise -1.
+    @return Positive integer holding a Socket ID handle if successful, otherwise -1. In worker mode, the endpoint
+        is opened later by each worker and zero is returned if the endpoint can be bound.
     @ingroup Webs
     @stability Stable
  */
@@ -2796,6 +3215,36 @@ PUBLIC void websPump(Webs *wp);
  */
 PUBLIC int websDefineAction(cchar *name, void *fun);
 
+/**
+    Define an asynchronous action callback for use with the action handler.
+    @description The action callback runs on a pool of ME_GOAHEAD_ACTION_THREADS worker threads so that blocking
+        operations do not stall other connections. The event loop is woken when the callback returns and the
+        completion callback then writes the response on the event loop thread. The action callback is passed a copy
+        of the request inputs and must not call any Webs, hash, socket or event API, as these are not thread safe.
+        Memory allocated by the action callback must use walloc, which is not thread safe if goahead.replaceMalloc is
+        enabled. In that case, or if threads are not supported, the callbacks run synchronously.
+    @param name URI path suffix. This suffix is added to "/action" to form the bound URI path.
+    @param fun Callback function to run on a worker thread.
+    @param done Completion callback function to run on the event loop thread. If NULL, the result is written as a
+        200 response and websDone is called.
+    @return Zero if successful, otherwise -1.
+    @ingroup Webs
+    @stability Prototype
+ */
+PUBLIC int websDefineAsyncAction(cchar *name, WebsAsyncAction fun, WebsAsyncDone done);
+
+/**
+    Get a request variable in an asynchronous action
+    @description This may be called from the action worker thread. It reads only the WebsAsync copy.
+    @param async Copy of the request inputs passed to the WebsAsyncAction callback
+    @param var Variable name
+    @param defaultValue Default value to return if the variable is not defined
+    @return Variable value or the default value
+    @ingroup Webs
+    @stability Prototype
+ */
+PUBLIC cchar *websGetAsyncVar(WebsAsync *async, cchar *var, cchar *defaultValue);
+
 /**
     Read data from an open file
     @param fd Open file handle returned by websOpenFile
@@ -2919,6 +3368,109 @@ PUBLIC int websServer(cchar *endpoint, cchar *documents);
  */
 PUBLIC void websServiceEvents(int *finished);
 
+/**
+    Event loop statistics
+    @description Statistics collected by websServiceEvents when ME_GOAHEAD_STATS is enabled. Times are in
+        microseconds. The "lag" of an iteration is the time it spends outside of waiting for I/O. This is the
+        worst delay a newly ready socket may see before it is serviced.
+    @ingroup Webs
+    @stability Prototype
+ */
+typedef struct WebsLoopStats {
+    int64   started;            /**< Tick time in milliseconds when the statistics were last reset */
+    int64   iterations;         /**< Number of event loop iterations */
+    int64   elapsed;            /**< Total time in all iterations */
+    int64   wait;               /**< Total time waiting for I/O in socketSelect */
+    int64   process;            /**< Total time in socketProcess servicing ready sockets */
+    int64   cgi;                /**< Total time polling CGI processes in websCgiPoll */
+    int64   events;             /**< Total time running timed events in websRunEvents */
+    int64   lastIteration;      /**< Duration of the last iteration */
+    int64   maxIteration;       /**< Duration of the longest iteration */
+    int64   lastLag;            /**< Lag of the last iteration */
+    int64   maxLag;             /**< Worst lag of an iteration */
+    int64   ready;              /**< Total number of ready sockets */
+    int     lastReady;          /**< Number of ready sockets in the last iteration */
+    int     maxReady;           /**< Largest number of ready sockets in one iteration */
+    int64   handlers;           /**< Number of socket handler callbacks */
+    int64   handlerTime;        /**< Total time in socket handler callbacks */
+    int64   maxHandler;         /**< Duration of the longest socket handler callback */
+} WebsLoopStats;
+
+/**
+    Get the event loop statistics
+    @param stats Structure to receive the statistics
+    @ingroup Webs
+    @stability Prototype
+ */
+PUBLIC void websGetLoopStats(WebsLoopStats *stats);
+
+/**
+    Reset the event loop statistics
+    @description This resets all counters and maximums. Use to measure over a specific interval.
+    @ingroup Webs
+    @stability Prototype
+ */
+PUBLIC void websResetLoopStats();
+
+#if ME_GOAHEAD_STATS
+/**
+    Action to serve the server statistics
+    @description Returns the event loop, connection pool, request and connection statistics as JSON. Only the GET
+        and HEAD methods are supported. The statistics describe server internals, so the action is not defined by
+        default. To serve it, define it via websDefineAction("stats", websStatsAction) and require authentication
+        for its route in route.txt.
+    @param wp Webs request object
+    @ingroup Webs
+    @stability Prototype
+ */
+PUBLIC void websStatsAction(Webs *wp);
+#endif
+
+/**
+    Get the connection object pool statistics
+    @description Closed connection objects are retained, with their buffers, in a pool of up to ME_GOAHEAD_LIMIT_POOL
+        entries for reuse by subsequent connections.
+    @param idle Set to the number of idle objects currently in the pool. May be null.
+    @param hits Set to the number of connections that were allocated from the pool. May be null.
+    @param misses Set to the number of connections that required a new allocation. May be null.
+    @ingroup Webs
+    @stability Prototype
+ */
+PUBLIC void websGetPoolStats(int *idle, int64 *hits, int64 *misses);
+
+/**
+    Get the memory held by a connection
+    @description This is the size of the Webs and socket objects, the connection buffers and the request arena. It does
+        not include TLS state. Idle keep-alive connections release their buffers and arena until the next request.
+    @param wp Webs request object
+    @return Memory in bytes
+    @ingroup Webs
+    @stability Prototype
+ */
+PUBLIC ssize websGetConnMemory(Webs *wp);
+
+/**
+    Get the open connection statistics
+    @param open Set to the number of open connections. May be null.
+    @param idle Set to the number of idle keep-alive connections that have released their buffers. May be null.
+    @param memory Set to the total memory held by open connections. See websGetConnMemory. May be null.
+    @param spare Set to the memory of buffers released by idle connections and retained for reuse. May be null.
+    @ingroup Webs
+    @stability Prototype
+ */
+PUBLIC void websGetConnStats(int *open, int *idle, ssize *memory, ssize *spare);
+
+/**
+    Get the request allocation statistics
+    @description Each completed request adds the number of memory allocations made from the start of the request
+        until websDone. See wallocCount.
+    @param requests Set to the number of completed requests. May be null.
+    @param allocs Set to the total allocations made by completed requests. May be null.
+    @ingroup Webs
+    @stability Prototype
+ */
+PUBLIC void websGetRequestStats(int64 *requests, int64 *allocs);
+
 /**
     Set the background processing flag
     @param on Value to set the background flag to.
@@ -2927,6 +3479,46 @@ PUBLIC void websServiceEvents(int *finished);
  */
 PUBLIC void websSetBackground(int on);
 
+/**
+    Set the number of worker processes
+    @description If set to a non-zero value before calling websListen, websListen only verifies the endpoints can
+        be bound and websStartWorkers will fork this number of worker processes. The master never listens. Each
+        worker opens its own listening sockets with SO_REUSEPORT so the kernel distributes new connections across
+        the workers.
+        \n\n
+        State that is global to a process is not shared between workers. In particular, the session store is
+        per-worker and a client's connections may be accepted by different workers. Applications that use sessions
+        (including form-based login) should use basic or digest authentication, or run with a single process.
+        The hardware register mapping is created by websOpen before the workers are forked and is shared by all
+        workers. Sequences of register accesses that must not interleave should be bracketed by websLockRegisters
+        and websUnlockRegisters.
+    @param count Number of worker processes. Set to zero for a single process.
+    @ingroup Webs
+    @stability Prototype
+ */
+PUBLIC void websSetWorkers(int count);
+
+/**
+    Get the number of worker processes
+    @return The number of worker processes. Zero if running as a single process.
+    @ingroup Webs
+    @stability Prototype
+ */
+PUBLIC int websGetWorkers();
+
+/**
+    Start and supervise worker processes
+    @description This forks the configured number of worker processes. In the master process, this routine
+        supervises the workers and restarts any that exit until *finished is set. Then it terminates the workers
+        and returns 1. In a worker process, this returns zero after the worker has opened its own listening
+        sockets. The worker should then call websServiceEvents. Call after websListen.
+    @param finished Integer to monitor. When set to a non-zero value, the master stops the workers and returns.
+    @return 1 in the master process, zero in a worker process and -1 on errors.
+    @ingroup Webs
+    @stability Prototype
+ */
+PUBLIC int websStartWorkers(int *finished);
+
 /**
     Define a background write I/O event callback
     @param wp Webs request object
@@ -2975,6 +3567,9 @@ PUBLIC void websSetDocuments(cchar *dir);
 
 /**
     Create the CGI environment variables for the current request.
+    @description The standard CGI variables such as REMOTE_ADDR and SERVER_NAME are served by websGetVar from the
+        request without being defined. This defines them as request variables for handlers that enumerate wp->vars.
+        It also defines the HTTP_* header variables.
     @param wp Webs request object
     @ingroup Webs
     @stability Stable
@@ -2991,6 +3586,18 @@ PUBLIC void websSetEnv(Webs *wp);
  */
 PUBLIC void websSetFormVars(Webs *wp);
 
+/**
+    Create request variables for the request headers
+    @description Headers are parsed without creating variables. This creates a HTTP_* variable for each header, named
+        by converting the header key to upper case and replacing '-' with '_'. Repeated headers are joined with ", ".
+        This is done on demand by websGetVar and websTestVar for HTTP_* names and by websSetEnv. This also creates the
+        wp->vars hash, which is otherwise created on first use, so call this before iterating over wp->vars directly.
+    @param wp Webs request object
+    @ingroup Webs
+    @stability Prototype
+ */
+PUBLIC void websSetHeaderVars(Webs *wp);
+
 /**
     Define the host name for the server
     @param host String host name
@@ -3106,6 +3713,21 @@ PUBLIC int websTimeOpen();
 */
 PUBLIC void websTimeClose();
 
+/**
+    Transfer a block of data to the response without copying
+    @description The block must be allocated by walloc. The request takes ownership of the block and frees it once
+        it has been written or the request is closed. The block is written after any buffered output with a single
+        vectored write. If the block cannot be queued without reordering output, it is copied via websWriteBlock.
+        Output written while the block is still queued is held until the block drains.
+    @param wp Webs request object
+    @param buf Block of data allocated by walloc
+    @param size Length of buf
+    @return Count of bytes accepted or -1 for errors.
+    @ingroup Webs
+    @stability Prototype
+ */
+PUBLIC ssize websTransferBlock(Webs *wp, char *buf, ssize size);
+
 /**
     Parse a date/time string
     @description Try to intelligently parse a date.
@@ -3226,7 +3848,8 @@ PUBLIC int websWriteHeader(Webs *wp, cchar *key, cchar *fmt, ...);
 /**
     Write data to the response
     @description The data is buffered and will be sent to the client when the buffer is full or websFlush is
-        called.
+        called. The data is formatted directly into the free space of the output buffer. A temporary buffer is only
+        allocated if the formatted data does not fit.
     @param wp Webs request object
     @param fmt Printf style format string.
     @param ... Arguments to the format string.
@@ -3250,11 +3873,16 @@ PUBLIC ssize websWriteFile(int fd, cchar *buf, ssize size);
 /**
     Write a block of data to the response
     @description The data is buffered and will be sent to the client when the buffer is full or websFlush is
-        called. This routine will never return "short", it will always write all the data unless there are errors.
+        called. This never blocks. If the socket cannot accept more data, the output buffer grows up to
+        ME_GOAHEAD_LIMIT_OUTPUT bytes. Beyond that, handlers that can resume writing should set WEBS_NONBLOCK in
+        wp->flags (websSetBackgroundWriter does this). For these, the write returns "short" and the handler should
+        write the remainder when invoked again after the socket becomes writable. JST pages suspend between scripts.
+        For other handlers, the response is aborted and the connection closed. Handlers that write large responses
+        should use websSetBackgroundWriter or websTransferBlock.
     @param wp Webs request object
     @param buf Buffer of data to write
     @param size Length of buf
-    @return Count of bytes written or -1. This will always equal size if there are no errors.
+    @return Count of bytes written or -1. This may be less than size if WEBS_NONBLOCK is set.
     @ingroup Webs
     @stability Stable
  */
@@ -3274,6 +3902,20 @@ PUBLIC ssize websWriteBlock(Webs *wp, cchar *buf, ssize size);
  */
 PUBLIC ssize websWriteSocket(Webs *wp, cchar *buf, ssize size);
 
+/**
+    Write a vector of data blocks to the network
+    @description This bypasses output buffering. The blocks are written with a single gathered write where possible.
+    @param wp Webs request object
+    @param iov Array of data blocks to write
+    @param count Number of elements in iov. Must not exceed WEBS_MAX_IOVEC.
+    @param more Set to true if more response data will follow. See socketSetCork.
+    @return Count of bytes written. May be less than the total length if the socket is in non-blocking mode.
+        Returns -1 for errors. If the transport is saturated, errno will be set to EAGAIN or EWOULDBLOCK.
+    @ingroup Webs
+    @stability Prototype
+ */
+PUBLIC ssize websWriteSocketVector(Webs *wp, WebsIOVec *iov, int count, bool more);
+
 #if ME_GOAHEAD_UPLOAD
 /**
     Process upload data for form, multipart mime file upload.
@@ -3403,6 +4045,15 @@ PUBLIC int websDefineJst(cchar *name, WebsJstProc fn);
  */
 PUBLIC int websJstOpen();
 
+/**
+    Free the state of a JST page that is being rendered
+    @description This is called when a request ends before the page is fully rendered.
+    @param wp Webs request object
+    @ingroup Webs
+    @stability Prototype
+ */
+PUBLIC void websFreeJst(Webs *wp);
+
 /**
     Write data to the response
     @param jid Javascript ID handle
@@ -3435,6 +4086,12 @@ unsigned int REG_READ_4byte(int offset);
 void PL_REG_WRITE(unsigned int addr, unsigned int value);
 unsigned int PL_REG_READ(int offset);
 
+/*
+    Serialize multi-register sequences between worker processes and asynchronous action threads
+ */
+PUBLIC void websLockRegisters();
+PUBLIC void websUnlockRegisters();
+
 PUBLIC int websJstWrite(int jid, Webs *wp, int argc, char **argv);
 PUBLIC int websJstReadVer(int jid, Webs *wp, int argc, char **argv);
 PUBLIC int websJstGetVol(int jid, Webs *wp, int argc, char **argv);
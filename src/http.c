@@ -16,6 +16,55 @@
 #define WEBS_TIMEOUT (ME_GOAHEAD_LIMIT_TIMEOUT * 1000)
 #define PARSE_TIMEOUT (ME_GOAHEAD_LIMIT_PARSE_TIMEOUT * 1000)
 #define CHUNK_LOW   128                 /* Low water mark for chunking */
+#define CHUNK_PREFIX "\r\n00000000\r\n" /* Placeholder transmit chunk prefix. The zeros are replaced by the size */
+#define CHUNK_DIGITS ((int) sizeof(CHUNK_PREFIX) - 5)  /* Hex digits reserved for chunk sizes. Exceeds any output buffer */
+#define BUF_HIGH    (ME_GOAHEAD_LIMIT_BUFFER * 16)  /* High water mark above which reused buffers are shrunk */
+#define PIPELINE_HIGH (ME_GOAHEAD_LIMIT_BUFFER * 8)  /* Coalesced pipelined output above which responses are flushed */
+
+/*
+    Reuse modes for initWebs and termWebs
+ */
+#define WEBS_REUSE_CONN     0x1         /* Keep-alive: retain the connection and receive buffer */
+#define WEBS_REUSE_BUFS     0x2         /* Retain the buffers and vars hash, reset in place */
+
+/*
+    Initial and maximum connection buffer sizes. Active connections grow their buffers up to WEBS_BUFFER_MAX to
+    write and read in larger blocks. Idle connections release their buffers, see releaseBufs.
+ */
+#define WEBS_INPUT_SIZE     (ME_GOAHEAD_LIMIT_BUFFER + 1)
+#define WEBS_INPUT_MAX      (ME_GOAHEAD_LIMIT_PUT + 1)
+#define WEBS_OUTPUT_SIZE    (ME_GOAHEAD_LIMIT_BUFFER + 1)
+#define WEBS_OUTPUT_MAX     max(ME_GOAHEAD_LIMIT_OUTPUT, ME_GOAHEAD_LIMIT_BUFFER + 1)
+#define WEBS_BUFFER_MAX     min(max(ME_GOAHEAD_LIMIT_BUFFER_MAX, WEBS_OUTPUT_SIZE), WEBS_OUTPUT_MAX)
+#define WEBS_RXBUF_SIZE     ME_GOAHEAD_LIMIT_HEADERS
+#define WEBS_RXBUF_MAX      (ME_GOAHEAD_LIMIT_HEADERS + ME_GOAHEAD_LIMIT_PUT)
+#define WEBS_ARENA_SIZE     2048        /* Initial request string arena size */
+
+/*
+    Buffers, arena and vars hash of a connection. Idle keep-alive connections release these so they hold only the
+    Webs object. Released sets are retained in spareBufs for the next connection that becomes active.
+ */
+typedef struct SpareBufs {
+    WebsBuf     rxbuf;
+    WebsBuf     input;
+    WebsBuf     output;
+    WebsArena   arena;
+    WebsHash    vars;
+} SpareBufs;
+
+/*
+    Pre-rendered response headers for a protocol, status code and extension. The text holds the status line and
+    Server header, then the Content-Type header, then the Cache-Control and X-Frame-Options headers. The headers that
+    vary per response are written between these parts. See getHeaderTemplate.
+ */
+typedef struct HeaderTemplate {
+    ssize       statusLen;              /* Length of the status line and Server header */
+    ssize       typeEnd;                /* Offset of the end of the Content-Type header */
+    ssize       len;                    /* Length of the text */
+    char        text[1];                /* Header text (null terminated) */
+} HeaderTemplate;
+
+#define WEBS_TEMPLATE_EXT   16          /* Longest extension with its own header template */
 
 /************************************ Locals **********************************/
 
@@ -24,9 +73,24 @@ static int          websDebug;                  /* Run in debug mode and defeat
 static int          defaultHttpPort;            /* Default port number for http */
 static int          defaultSslPort;             /* Default port number for https */
 static int          listens[WEBS_MAX_LISTEN];   /* Listen endpoints */;
+static char         *listenEndpoints[WEBS_MAX_LISTEN];  /* Endpoint specifications for listens */
+static int          listenFlags[WEBS_MAX_LISTEN];       /* Socket flags used to open each listen endpoint */
 static int          listenMax;                  /* Max entry in listens */
+static int          workerCount = ME_GOAHEAD_WORKERS;  /* Number of worker processes */
+#if ME_GOAHEAD_STATS
+static WebsLoopStats loopStats;                 /* Event loop statistics */
+#endif
 static Webs         **webs;                     /* Open connection list head */
+static Webs         **websPool;                 /* Idle connection objects retained for reuse */
+static int          websPoolCount;              /* Number of idle objects in websPool */
+static int64        websPoolHits;               /* Connections allocated from the pool */
+static int64        websPoolMisses;             /* Connections that required a new allocation */
+static SpareBufs    *spareBufs;                 /* Buffer sets released by idle keep-alive connections */
+static int          spareCount;                 /* Number of sets in spareBufs */
+static int64        websRequests;               /* Completed requests */
+static int64        websRequestAllocs;          /* Allocations made by completed requests */
 static WebsHash     websMime;                   /* Set of mime types */
+static WebsHash     headerTemplates = -1;       /* Pre-rendered response headers */
 static int          websMax;                    /* List size */
 static char         websHost[ME_MAX_IP];        /* Host name for the server */
 static char         websIpAddr[ME_MAX_IP];      /* IP address for the server */
@@ -181,6 +245,16 @@ static WebsError websErrors[] = {
     { 0, NULL }
 };
 
+/*
+    Standard CGI variables. These are served from the request by websGetVar and only defined by websSetEnv.
+ */
+static cchar *envVars[] = {
+    "AUTH_TYPE", "CONTENT_LENGTH", "CONTENT_TYPE", "DOCUMENT_ROOT", "GATEWAY_INTERFACE", "PATH_INFO",
+    "PATH_TRANSLATED", "QUERY_STRING", "REMOTE_ADDR", "REMOTE_USER", "REMOTE_HOST", "REQUEST_METHOD",
+    "REQUEST_TRANSPORT", "REQUEST_URI", "SERVER_ADDR", "SERVER_HOST", "SERVER_NAME", "SERVER_PORT",
+    "SERVER_PROTOCOL", "SERVER_URL", "SERVER_SOFTWARE", 0
+};
+
 #if ME_GOAHEAD_ACCESS_LOG && !ME_ROM
 static char     accessLog[64] = "access.log";       /* Log filename */
 static int      accessFd;                           /* Log file handle */
@@ -190,20 +264,55 @@ static WebsHash sessions = -1;
 static int      sessionCount = 0;
 static int      pruneId;                            /* Callback ID */
 
+/*
+    Current date strings. Rendered when the second changes. See updateDate.
+ */
+static WebsTime dateTime = -1;                      /* Time of the cached strings */
+static char     dateString[32];                     /* Date response header value */
+#if ME_GOAHEAD_ACCESS_LOG
+static char     logTimeString[40];                  /* Access log time with zone */
+#endif
+
 /**************************** Forward Declarations ****************************/
 
+static int      allocBufs(Webs *wp);
 static void     checkTimeout(void *arg, int id);
+static int      complete(Webs *wp, int reuse);
+static bool     clientCache(cchar *ext);
+static void     closeChunk(Webs *wp);
+static HeaderTemplate *createHeaderTemplate(cchar *protoVersion, int code, cchar *ext);
+static bool     deferFlush(Webs *wp);
 static bool     filterChunkData(Webs *wp);
+static char     *findHeaderEnd(Webs *wp);
+static int      flushOutput(Webs *wp, bool block, bool more);
+static bool     flushPipeline(Webs *wp);
+static bool     growBuf(Webs *wp, WebsBuf *bp);
+static void     freeTxBlock(Webs *wp);
+static cchar    *getEnvVar(Webs *wp, cchar *var);
+static WebsHash getVars(Webs *wp);
+static void     freePool();
+static HeaderTemplate *getHeaderTemplate(Webs *wp, cchar *protoVersion);
 static int      getTimeSinceMark(Webs *wp);
 static char     *getToken(Webs *wp, char *delim);
+static ssize    outputRoom(Webs *wp);
 static void     parseFirstLine(Webs *wp);
-static void     parseHeaders(Webs *wp);
+static void     parseHeaders(Webs *wp, char *end);
 static bool     processContent(Webs *wp);
+static void     updateDate();
+static int      writeHeaderText(Webs *wp, cchar *text, ssize len);
+static int      writeHeaderValue(Webs *wp, cchar *key, cchar *value);
+static ssize    writeOutput(Webs *wp, bool more);
 static bool     parseIncoming(Webs *wp);
 static void     pruneSessions();
+static bool     spillTxBlock(Webs *wp);
 static void     freeSession(WebsSession *sp);
 static void     freeSessions();
+#if ME_UNIX_LIKE
+static int      initWorker();
+#endif
 static void     readEvent(Webs *wp);
+static void     recycleBuf(WebsBuf *bp, int initSize, int maxsize, ssize high);
+static void     releaseBufs(Webs *wp);
 static void     reuseConn(Webs *wp);
 static void     setFileLimits();
 static int      setLocalHost();
@@ -221,6 +330,13 @@ PUBLIC int websOpen(cchar *documents, cchar *routeFile)
 
     webs = NULL;
     websMax = 0;
+    websPoolCount = 0;
+    websPoolHits = websPoolMisses = 0;
+    spareCount = 0;
+    if (ME_GOAHEAD_LIMIT_POOL > 0) {
+        websPool = walloc(ME_GOAHEAD_LIMIT_POOL * sizeof(Webs*));
+        spareBufs = walloc(ME_GOAHEAD_LIMIT_POOL * sizeof(SpareBufs));
+    }
 
     websOsOpen();
     websRuntimeOpen();
@@ -254,6 +370,9 @@ PUBLIC int websOpen(cchar *documents, cchar *routeFile)
 #endif
     websOptionsOpen();
     websActionOpen();
+#if ME_GOAHEAD_STATS
+    websResetLoopStats();
+#endif
     websFileOpen();
 #if ME_GOAHEAD_UPLOAD
     websUploadOpen();
@@ -277,6 +396,7 @@ PUBLIC int websOpen(cchar *documents, cchar *routeFile)
     for (mt = websMimeList; mt->type; mt++) {
         hashEnter(websMime, mt->ext, valueString(mt->type, 0), 0);
     }
+    headerTemplates = hashCreate(WEBS_HASH_INIT);
 
 #if ME_GOAHEAD_ACCESS_LOG && !ME_ROM
     if ((accessFd = open(accessLog, O_CREAT | O_TRUNC | O_APPEND | O_WRONLY, 0666)) < 0) {
@@ -293,6 +413,7 @@ PUBLIC int websOpen(cchar *documents, cchar *routeFile)
 PUBLIC void websClose()
 {
     Webs    *wp;
+    WebsKey *key;
     int     i;
 
     websCloseRoute();
@@ -311,6 +432,9 @@ PUBLIC void websClose()
             socketCloseConnection(listens[i]);
             listens[i] = -1;
         }
+        wfree(listenEndpoints[i]);
+        listenEndpoints[i] = 0;
+        listenFlags[i] = 0;
     }
     listenMax = 0;
     for (i = websMax; webs && i >= 0; i--) {
@@ -323,6 +447,7 @@ PUBLIC void websClose()
         }
         websFree(wp);
     }
+    freePool();
     wfree(websHostUrl);
     wfree(websIpAddrUrl);
     websIpAddrUrl = websHostUrl = NULL;
@@ -338,6 +463,13 @@ PUBLIC void websClose()
 #endif
     websFsClose();
     hashFree(websMime);
+    if (headerTemplates >= 0) {
+        for (key = hashFirst(headerTemplates); key; key = hashNext(headerTemplates, key)) {
+            wfree(key->content.value.symbol);
+        }
+        hashFree(headerTemplates);
+        headerTemplates = -1;
+    }
     socketClose();
     logClose();
     websTimeClose();
@@ -346,22 +478,36 @@ PUBLIC void websClose()
 }
 
 
+/*
+    Initialize a connection object. If reuse is WEBS_REUSE_CONN, the connection state and receive buffer are retained
+    for a keep-alive request. If WEBS_REUSE_BUFS, the buffers and vars hash (already reset by termWebs) are retained.
+ */
 static void initWebs(Webs *wp, int flags, int reuse)
 {
-    WebsBuf     rxbuf;
+    WebsBuf     rxbuf, input, output;
+    WebsArena   arena;
+    WebsHash    vars;
     void        *ssl;
     char        ipaddr[ME_MAX_IP], ifaddr[ME_MAX_IP];
+    ssize       txBufSize;
+    int64       allocs;
     int         wid, sid, timeout, listenSid;
 
     assert(wp);
-
-    if (reuse) {
-        rxbuf = wp->rxbuf;
+    allocs = wallocCount();
+
+    rxbuf = wp->rxbuf;
+    input = wp->input;
+    output = wp->output;
+    vars = wp->vars;
+    arena = wp->arena;
+    if (reuse & WEBS_REUSE_CONN) {
         wid = wp->wid;
         sid = wp->sid;
         timeout = wp->timeout;
         ssl = wp->ssl;
         listenSid = wp->listenSid;
+        txBufSize = wp->txBufSize;
         scopy(ipaddr, sizeof(ipaddr), wp->ipaddr);
         scopy(ifaddr, sizeof(ifaddr), wp->ifaddr);
     } else {
@@ -369,6 +515,7 @@ static void initWebs(Webs *wp, int flags, int reuse)
         timeout = -1;
         ssl = 0;
         listenSid = -1;
+        txBufSize = 0;
     }
     memset(wp, 0, sizeof(Webs));
     wp->flags = flags;
@@ -376,6 +523,7 @@ static void initWebs(Webs *wp, int flags, int reuse)
     wp->wid = wid;
     wp->sid = sid;
     wp->timeout = timeout;
+    wp->txBufSize = txBufSize;
     wp->docfd = -1;
     wp->txLen = -1;
     wp->rxLen = -1;
@@ -385,36 +533,124 @@ static void initWebs(Webs *wp, int flags, int reuse)
 #if !ME_ROM
     wp->putfd = -1;
 #endif
-#if ME_GOAHEAD_CGI
-    wp->cgifd = -1;
-#endif
 #if ME_GOAHEAD_UPLOAD
     wp->files = -1;
-    wp->upfd = -1;
 #endif
-    if (reuse) {
+    if (reuse & WEBS_REUSE_CONN) {
         scopy(wp->ipaddr, sizeof(wp->ipaddr), ipaddr);
         scopy(wp->ifaddr, sizeof(wp->ifaddr), ifaddr);
     } else {
         wp->timeout = -1;
     }
-    wp->vars = hashCreate(WEBS_HASH_INIT);
+    if (reuse & WEBS_REUSE_BUFS) {
+        wp->vars = vars;
+        wp->arena = arena;
+        wp->output = output;
+        wp->input = input;
+        wp->rxbuf = rxbuf;
+    } else {
+        wp->vars = -1;
+        allocBufs(wp);
+    }
+    wp->allocs = allocs;
+}
+
+
+/*
+    Ensure the connection has its buffers and arena. These are released while a keep-alive connection is idle.
+    Reuse a spare set if available. Returns zero if successful, otherwise -1.
+ */
+static int allocBufs(Webs *wp)
+{
+    SpareBufs   *sp;
+
+    if (wp->rxbuf.buf) {
+        return 0;
+    }
+    if (spareCount > 0) {
+        sp = &spareBufs[--spareCount];
+        wp->rxbuf = sp->rxbuf;
+        wp->input = sp->input;
+        wp->output = sp->output;
+        wp->arena = sp->arena;
+        wp->vars = sp->vars;
+        return 0;
+    }
     /*
         Ring queues can never be totally full and are short one byte. Better to do even I/O and allocate
-        a little more memory than required. The chunkbuf has extra room to fit chunk headers and trailers.
+        a little more memory than required.
+        Most requests never define a var, so the vars hash is created on first use.
      */
     assert(ME_GOAHEAD_LIMIT_BUFFER >= 1024);
-    bufCreate(&wp->output, ME_GOAHEAD_LIMIT_BUFFER + 1, ME_GOAHEAD_LIMIT_BUFFER + 1);
-    bufCreate(&wp->chunkbuf, ME_GOAHEAD_LIMIT_BUFFER + 1, ME_GOAHEAD_LIMIT_BUFFER * 2);
-    bufCreate(&wp->input, ME_GOAHEAD_LIMIT_BUFFER + 1, ME_GOAHEAD_LIMIT_PUT + 1);
-    if (reuse) {
-        wp->rxbuf = rxbuf;
+    if (arenaCreate(&wp->arena, WEBS_ARENA_SIZE) < 0 ||
+            bufCreate(&wp->output, WEBS_OUTPUT_SIZE, WEBS_OUTPUT_MAX) < 0 ||
+            bufCreate(&wp->input, WEBS_INPUT_SIZE, WEBS_INPUT_MAX) < 0 ||
+            bufCreate(&wp->rxbuf, WEBS_RXBUF_SIZE, WEBS_RXBUF_MAX) < 0) {
+        return -1;
+    }
+    return 0;
+}
+
+
+/*
+    Release the buffers, arena and vars of an idle keep-alive connection so it holds only the Webs object until its
+    next I/O event. The set is retained as a spare for reuse by any connection if there is room.
+ */
+static void releaseBufs(Webs *wp)
+{
+    SpareBufs   *sp;
+
+    if (!wp->rxbuf.buf) {
+        return;
+    }
+    if (spareBufs && spareCount < ME_GOAHEAD_LIMIT_POOL) {
+        sp = &spareBufs[spareCount++];
+        recycleBuf(&wp->rxbuf, WEBS_RXBUF_SIZE, WEBS_RXBUF_MAX, BUF_HIGH);
+        recycleBuf(&wp->input, WEBS_INPUT_SIZE, WEBS_INPUT_MAX, BUF_HIGH);
+        recycleBuf(&wp->output, WEBS_OUTPUT_SIZE, WEBS_OUTPUT_MAX, BUF_HIGH);
+        sp->rxbuf = wp->rxbuf;
+        sp->input = wp->input;
+        sp->output = wp->output;
+        sp->arena = wp->arena;
+        sp->vars = wp->vars;
+    } else {
+        bufFree(&wp->rxbuf);
+        bufFree(&wp->input);
+        bufFree(&wp->output);
+        arenaFree(&wp->arena);
+        hashFree(wp->vars);
+    }
+    memset(&wp->rxbuf, 0, sizeof(WebsBuf));
+    memset(&wp->input, 0, sizeof(WebsBuf));
+    memset(&wp->output, 0, sizeof(WebsBuf));
+    memset(&wp->arena, 0, sizeof(WebsArena));
+    wp->vars = -1;
+}
+
+
+/*
+    Reset a buffer in place for reuse. Buffers that have grown beyond the given high water mark are reallocated at
+    their initial size so that idle and keep-alive connections do not pin large allocations.
+ */
+static void recycleBuf(WebsBuf *bp, int initSize, int maxsize, ssize high)
+{
+    if (!bp->buf) {
+        /* Released while idle */
+        return;
+    }
+    if (bp->buflen > max(high, initSize)) {
+        bufFree(bp);
+        bufCreate(bp, initSize, maxsize);
     } else {
-        bufCreate(&wp->rxbuf, ME_GOAHEAD_LIMIT_HEADERS, ME_GOAHEAD_LIMIT_HEADERS + ME_GOAHEAD_LIMIT_PUT);
+        bufFlush(bp);
     }
 }
 
 
+/*
+    Release the resources of a request. If reuse is WEBS_REUSE_CONN, the connection and receive buffer are retained for
+    a keep-alive request. If WEBS_REUSE_BUFS, the buffers and vars hash are reset in place and retained.
+ */
 static void termWebs(Webs *wp, int reuse)
 {
     assert(wp);
@@ -422,11 +658,33 @@ static void termWebs(Webs *wp, int reuse)
     /*
         Some of this is done elsewhere, but keep this here for when a shutdown is done and there are open connections.
      */
-    bufFree(&wp->input);
-    bufFree(&wp->output);
-    bufFree(&wp->chunkbuf);
-    if (!reuse) {
-        bufFree(&wp->rxbuf);
+    if (wp->txBlock) {
+        freeTxBlock(wp);
+    }
+    if (reuse & WEBS_REUSE_BUFS) {
+        recycleBuf(&wp->input, WEBS_INPUT_SIZE, WEBS_INPUT_MAX, BUF_HIGH);
+        if ((reuse & WEBS_REUSE_CONN) && bufLen(&wp->output) > 0) {
+            /* Retain responses to pipelined requests that are not yet flushed */
+            bufCompact(&wp->output);
+        } else if (reuse & WEBS_REUSE_CONN) {
+            /*
+                Keep an output buffer suited to the responses on this connection. Growth may double the buffer
+                beyond the size hint, so allow for that.
+             */
+            recycleBuf(&wp->output, WEBS_OUTPUT_SIZE, WEBS_OUTPUT_MAX, min(wp->txBufSize * 2, WEBS_BUFFER_MAX));
+        } else {
+            recycleBuf(&wp->output, WEBS_OUTPUT_SIZE, WEBS_OUTPUT_MAX, BUF_HIGH);
+        }
+    } else {
+        bufFree(&wp->input);
+        bufFree(&wp->output);
+    }
+    if (!(reuse & WEBS_REUSE_CONN)) {
+        if (reuse & WEBS_REUSE_BUFS) {
+            recycleBuf(&wp->rxbuf, WEBS_RXBUF_SIZE, WEBS_RXBUF_MAX, BUF_HIGH);
+        } else {
+            bufFree(&wp->rxbuf);
+        }
         if (wp->sid >= 0) {
 #if ME_COM_SSL
             sslFree(wp);
@@ -447,75 +705,68 @@ static void termWebs(Webs *wp, int reuse)
     }
 #endif
 #if ME_GOAHEAD_CGI
-    if (wp->cgifd >= 0) {
-        close(wp->cgifd);
-        wp->cgifd = -1;
+    if (wp->cgiState && wp->cgiState->fd >= 0) {
+        close(wp->cgiState->fd);
+        wp->cgiState->fd = -1;
     }
-    wfree(wp->cgiStdin);
 #endif
-#if ME_GOAHEAD_UPLOAD
-    wfree(wp->clientFilename);
+#if ME_GOAHEAD_JAVASCRIPT
+    if (wp->jstState) {
+        websFreeJst(wp);
+    }
 #endif
     websPageClose(wp);
-    if (wp->timeout >= 0 && !reuse) {
+    if (wp->timeout >= 0 && !(reuse & WEBS_REUSE_CONN)) {
         websCancelTimeout(wp);
     }
-    wfree(wp->authDetails);
-    wfree(wp->authResponse);
-    wfree(wp->authType);
-    wfree(wp->contentType);
-    wfree(wp->cookie);
-    wfree(wp->decodedQuery);
-    wfree(wp->digest);
-    wfree(wp->ext);
-    wfree(wp->filename);
-    wfree(wp->host);
-    wfree(wp->method);
-    wfree(wp->password);
-    wfree(wp->path);
-    wfree(wp->protoVersion);
-    wfree(wp->putname);
-    wfree(wp->query);
-    wfree(wp->realm);
-    wfree(wp->referrer);
-    wfree(wp->responseCookie);
-    wfree(wp->url);
-    wfree(wp->userAgent);
-    wfree(wp->username);
-#if ME_GOAHEAD_UPLOAD
-    wfree(wp->boundary);
-    wfree(wp->uploadTmp);
-    wfree(wp->uploadVar);
-#endif
-#if ME_GOAHEAD_DIGEST
-    wfree(wp->cnonce);
-    wfree(wp->digestUri);
-    wfree(wp->opaque);
-    wfree(wp->nc);
-    wfree(wp->nonce);
-    wfree(wp->qop);
-#endif
-    hashFree(wp->vars);
-
 #if ME_GOAHEAD_UPLOAD
-    if (wp->files >= 0) {
+    if (wp->uploadState || wp->files >= 0) {
         websFreeUpload(wp);
     }
 #endif
+    /*
+        Var values, request strings and the feature side structures are allocated from the arena, so release the
+        vars first
+     */
+    if (reuse & WEBS_REUSE_BUFS) {
+        hashClear(wp->vars);
+        arenaReset(&wp->arena);
+    } else {
+        hashFree(wp->vars);
+        arenaFree(&wp->arena);
+    }
 }
 
 
+/*
+    Allocate a connection object. Idle objects in the pool are reused with their buffers so that accepting a
+    connection does not allocate in the steady state.
+ */
 PUBLIC int websAlloc(int sid)
 {
     Webs    *wp;
     int     wid;
 
-    if ((wid = wallocObject(&webs, &websMax, sizeof(Webs))) < 0) {
-        return -1;
+    if (websPoolCount > 0) {
+        if ((wid = wallocHandle(&webs)) < 0) {
+            return -1;
+        }
+        if (wid >= websMax) {
+            websMax = wid + 1;
+        }
+        wp = websPool[--websPoolCount];
+        webs[wid] = wp;
+        initWebs(wp, 0, WEBS_REUSE_BUFS);
+        websPoolHits++;
+    } else {
+        if ((wid = wallocObject(&webs, &websMax, sizeof(Webs))) < 0) {
+            return -1;
+        }
+        wp = webs[wid];
+        assert(wp);
+        initWebs(wp, 0, 0);
+        websPoolMisses++;
     }
-    wp = webs[wid];
-    assert(wp);
-    initWebs(wp, 0, 0);
     wp->wid = wid;
     wp->sid = sid;
     wp->timestamp = time(0);
@@ -528,33 +779,164 @@ static void reuseConn(Webs *wp)
     assert(wp);
     assert(websValid(wp));
 
+    /*
+        Any pipelined request already in the rxbuf is parsed directly by websPump
+     */
     bufCompact(&wp->rxbuf);
-    if (bufLen(&wp->rxbuf)) {
-        socketReservice(wp->sid);
+
+    /*
+        Adapt the output buffer size for the next response to the responses seen so far. Larger responses raise it
+        immediately. Smaller responses decay it by half.
+     */
+    if (wp->written > wp->txBufSize) {
+        wp->txBufSize = min(wp->written, WEBS_BUFFER_MAX);
+    } else {
+        wp->txBufSize = max(wp->written, wp->txBufSize / 2);
     }
-    termWebs(wp, 1);
-    initWebs(wp, wp->flags & (WEBS_KEEP_ALIVE | WEBS_SECURE | WEBS_HTTP11), 1);
+    termWebs(wp, WEBS_REUSE_CONN | WEBS_REUSE_BUFS);
+    initWebs(wp, wp->flags & (WEBS_KEEP_ALIVE | WEBS_SECURE | WEBS_HTTP11), WEBS_REUSE_CONN | WEBS_REUSE_BUFS);
 }
 
 
+/*
+    Free a connection object. The object and its buffers are retained in the pool if there is room.
+ */
 PUBLIC void websFree(Webs *wp)
 {
     assert(wp);
     assert(websValid(wp));
 
-    termWebs(wp, 0);
-    websMax = wfreeHandle(&webs, wp->wid);
-    wfree(wp);
+    if (websPool && websPoolCount < ME_GOAHEAD_LIMIT_POOL) {
+        termWebs(wp, WEBS_REUSE_BUFS);
+        websMax = wfreeHandle(&webs, wp->wid);
+        wp->wid = -1;
+        websPool[websPoolCount++] = wp;
+    } else {
+        termWebs(wp, 0);
+        websMax = wfreeHandle(&webs, wp->wid);
+        wfree(wp);
+    }
     assert(websMax >= 0);
 }
 
 
+static void freePool()
+{
+    Webs        *wp;
+    SpareBufs   *sp;
+
+    while (websPoolCount > 0) {
+        wp = websPool[--websPoolCount];
+        bufFree(&wp->input);
+        bufFree(&wp->output);
+        bufFree(&wp->rxbuf);
+        hashFree(wp->vars);
+        arenaFree(&wp->arena);
+        wfree(wp);
+    }
+    wfree(websPool);
+    websPool = 0;
+
+    while (spareCount > 0) {
+        sp = &spareBufs[--spareCount];
+        bufFree(&sp->rxbuf);
+        bufFree(&sp->input);
+        bufFree(&sp->output);
+        hashFree(sp->vars);
+        arenaFree(&sp->arena);
+    }
+    wfree(spareBufs);
+    spareBufs = 0;
+}
+
+
+PUBLIC void websGetPoolStats(int *idle, int64 *hits, int64 *misses)
+{
+    if (idle) {
+        *idle = websPoolCount;
+    }
+    if (hits) {
+        *hits = websPoolHits;
+    }
+    if (misses) {
+        *misses = websPoolMisses;
+    }
+}
+
+
+/*
+    Return the memory held by a connection. Idle keep-alive connections hold only the Webs and socket objects.
+ */
+PUBLIC ssize websGetConnMemory(Webs *wp)
+{
+    ssize   memory;
+
+    assert(wp);
+
+    memory = sizeof(Webs) + wp->rxbuf.buflen + wp->input.buflen + wp->output.buflen +
+        max(wp->arena.size, wp->arena.used);
+    if (wp->sid >= 0) {
+        memory += sizeof(WebsSocket);
+    }
+    return memory;
+}
+
+
+PUBLIC void websGetConnStats(int *open, int *idle, ssize *memory, ssize *spare)
+{
+    Webs        *wp;
+    SpareBufs   *sp;
+    ssize       total, spareTotal;
+    int         i, count, idleCount;
+
+    count = idleCount = 0;
+    total = spareTotal = 0;
+    for (i = 0; i < websMax; i++) {
+        if ((wp = webs[i]) != 0) {
+            count++;
+            if (!wp->rxbuf.buf) {
+                idleCount++;
+            }
+            total += websGetConnMemory(wp);
+        }
+    }
+    for (i = 0; i < spareCount; i++) {
+        sp = &spareBufs[i];
+        spareTotal += sp->rxbuf.buflen + sp->input.buflen + sp->output.buflen + sp->arena.size;
+    }
+    if (open) {
+        *open = count;
+    }
+    if (idle) {
+        *idle = idleCount;
+    }
+    if (memory) {
+        *memory = total;
+    }
+    if (spare) {
+        *spare = spareTotal;
+    }
+}
+
+
+PUBLIC void websGetRequestStats(int64 *requests, int64 *allocs)
+{
+    if (requests) {
+        *requests = websRequests;
+    }
+    if (allocs) {
+        *allocs = websRequestAllocs;
+    }
+}
+
+
 /*
     Called when the request is complete. Note: it may not have fully drained from the tx buffer.
  */
 PUBLIC void websDone(Webs *wp)
 {
     WebsSocket  *sp;
+    int64       allocs;
 
     assert(wp);
     assert(websValid(wp));
@@ -568,7 +950,7 @@ PUBLIC void websDone(Webs *wp)
 #endif
     wp->finalized = 1;
 
-    if (wp->state < WEBS_COMPLETE) {
+    if (wp->state < WEBS_COMPLETE && !deferFlush(wp)) {
         /*
             Initiate flush. If not all flushed, wait for output to drain via a socket event.
          */
@@ -580,9 +962,72 @@ PUBLIC void websDone(Webs *wp)
 #if ME_GOAHEAD_ACCESS_LOG
     logRequest(wp, wp->code);
 #endif
+    allocs = wallocCount() - wp->allocs;
+    websRequestAllocs += allocs;
+    websRequests++;
     if (!(wp->flags & WEBS_RESPONSE_TRACED)) {
-        trace(3 | WEBS_RAW_MSG, "Request complete: code %d", wp->code);
+        trace(3 | WEBS_RAW_MSG, "Request complete: code %d, allocations %Ld", wp->code, allocs);
+    }
+}
+
+
+/*
+    Defer flushing a completed response if more pipelined input is already buffered. The response is retained in the
+    output buffer and written with the responses to the requests that follow. Returns true if the flush is deferred.
+ */
+static bool deferFlush(Webs *wp)
+{
+    WebsBuf     *op;
+
+    op = &wp->output;
+    if (!(wp->flags & WEBS_KEEP_ALIVE) || wp->rxRemaining > 0 || bufLen(&wp->rxbuf) == 0 || wp->txBlock) {
+        return 0;
+    }
+    if (wp->flags & WEBS_CHUNKING) {
+        closeChunk(wp);
+        if (bufRoom(op) <= 8) {
+            return 0;
+        }
+        bufPutStr(op, "\r\n0\r\n\r\n");
+        bufAddNull(op);
+        wp->flags &= ~WEBS_CHUNKING;
+    }
+    if (bufLen(op) >= PIPELINE_HIGH) {
+        return 0;
+    }
+    wp->state = WEBS_COMPLETE;
+    return 1;
+}
+
+
+/*
+    Write the coalesced responses once no further pipelined request is buffered. Writable events are requested
+    only while output remains. Returns true if the connection state has changed and websPump should proceed.
+ */
+static bool flushPipeline(Webs *wp)
+{
+    WebsSocket  *sp;
+
+    if (bufLen(&wp->output) > 0 && websFlush(wp, 0) < 0) {
+        return wp->state == WEBS_COMPLETE;
+    }
+    if (wp->state == WEBS_COMPLETE) {
+        return 1;
+    }
+    if ((sp = socketPtr(wp->sid)) == NULL) {
+        return 0;
+    }
+    if (bufLen(&wp->output) > 0) {
+        socketRegisterInterest(wp->sid, sp->handlerMask | SOCKET_WRITABLE);
+
+    } else if (socketEof(wp->sid)) {
+        /* The peer has closed after sending its requests and all responses are now written */
+        complete(wp, 0);
+
+    } else if (sp->handlerMask & SOCKET_WRITABLE) {
+        socketRegisterInterest(wp->sid, sp->handlerMask & ~SOCKET_WRITABLE);
     }
+    return 0;
 }
 
 
@@ -609,7 +1054,7 @@ PUBLIC int websListen(cchar *endpoint)
 {
     WebsSocket  *sp;
     char        *ip, *ipaddr;
-    int         port, secure, sid;
+    int         flags, port, secure, sid;
 
     assert(endpoint && *endpoint);
 
@@ -618,20 +1063,40 @@ PUBLIC int websListen(cchar *endpoint)
         return -1;
     }
     socketParseAddress(endpoint, &ip, &port, &secure, 80);
-    if ((sid = socketListen(ip, port, websAccept, 0)) < 0) {
-        error("Unable to open socket on port %d.", port);
-        return -1;
+    flags = workerCount > 0 ? SOCKET_REUSEPORT : 0;
+    if (ME_GOAHEAD_CORK) {
+        flags |= SOCKET_CORK;
+    }
+    if (workerCount > 0) {
+        /*
+            Each worker opens its own listener. The master only checks the endpoint can be bound. If the master
+            listened too, connections the kernel queued on its socket would be reset when it closed it.
+         */
+        if (socketListen(ip, port, websAccept, flags | SOCKET_NOLISTEN) < 0) {
+            error("Unable to open socket on port %d.", port);
+            wfree(ip);
+            return -1;
+        }
+        sid = 0;
+    } else {
+        if ((sid = socketListen(ip, port, websAccept, flags)) < 0) {
+            error("Unable to open socket on port %d.", port);
+            wfree(ip);
+            return -1;
+        }
+        sp = socketPtr(sid);
+        sp->secure = secure;
     }
-    sp = socketPtr(sid);
-    sp->secure = secure;
-    if (sp->secure) {
+    if (secure) {
         if (!defaultSslPort) {
             defaultSslPort = port;
         }
     } else if (!defaultHttpPort) {
         defaultHttpPort = port;
     }
-    listens[listenMax++] = sid;
+    listenEndpoints[listenMax] = sclone(endpoint);
+    listenFlags[listenMax] = flags;
+    listens[listenMax++] = workerCount > 0 ? -1 : sid;
     if (ip) {
         ipaddr = smatch(ip, "::") ? "[::]" : ip;
     } else {
@@ -685,15 +1150,20 @@ PUBLIC int websAccept(int sid, cchar *ipaddr, int port, int listenSid)
     strncpy(wp->ipaddr, ipaddr, min(sizeof(wp->ipaddr) - 1, strlen(ipaddr)));
 
     /*
-        Get the ip address of the interface that accept the connection.
+        Get the ip address of the interface that accept the connection. Listeners bound to a specific address cache it.
      */
-    len = sizeof(ifAddr);
-    if (getsockname(socketPtr(sid)->sock, (struct sockaddr*) &ifAddr, (Socklen*) &len) < 0) {
-        error("Cannot get sockname");
-        websFree(wp);
-        return -1;
+    lp = socketPtr(listenSid);
+    if (lp->ifaddr) {
+        scopy(wp->ifaddr, sizeof(wp->ifaddr), lp->ifaddr);
+    } else {
+        len = sizeof(ifAddr);
+        if (getsockname(socketPtr(sid)->sock, (struct sockaddr*) &ifAddr, (Socklen*) &len) < 0) {
+            error("Cannot get sockname");
+            websFree(wp);
+            return -1;
+        }
+        socketAddress((struct sockaddr*) &ifAddr, (int) len, wp->ifaddr, sizeof(wp->ifaddr), NULL);
     }
-    socketAddress((struct sockaddr*) &ifAddr, (int) len, wp->ifaddr, sizeof(wp->ifaddr), NULL);
 
 #if ME_GOAHEAD_LEGACY
     /*
@@ -709,7 +1179,6 @@ PUBLIC int websAccept(int sid, cchar *ipaddr, int port, int listenSid)
     /*
         Arrange for socketEvent to be called when read data is available
      */
-    lp = socketPtr(listenSid);
     trace(4, "New connection from %s:%d to %s:%d", ipaddr, port, wp->ifaddr, lp->port);
 
 #if ME_COM_SSL
@@ -745,11 +1214,16 @@ static void socketEvent(int sid, int mask, void *wptr)
     if (! websValid(wp)) {
         return;
     }
-    if (mask & SOCKET_READABLE) {
-        readEvent(wp);
-    }
-    if (mask & SOCKET_WRITABLE) {
-        writeEvent(wp);
+    if (allocBufs(wp) < 0) {
+        error("Cannot allocate connection buffers");
+        complete(wp, 0);
+    } else {
+        if (mask & SOCKET_READABLE) {
+            readEvent(wp);
+        }
+        if (mask & SOCKET_WRITABLE) {
+            writeEvent(wp);
+        }
     }
     if (wp->flags & WEBS_CLOSED) {
         websFree(wp);
@@ -784,7 +1258,7 @@ static void readEvent(Webs *wp)
 {
     WebsBuf     *rxbuf;
     WebsSocket  *sp;
-    ssize       nbytes;
+    ssize       nbytes, room;
 
     assert(wp);
     assert(websValid(wp));
@@ -795,14 +1269,18 @@ static void readEvent(Webs *wp)
     websNoteRequestActivity(wp);
     rxbuf = &wp->rxbuf;
 
-    if (bufRoom(rxbuf) < (ME_GOAHEAD_LIMIT_BUFFER + 1)) {
+    if ((room = bufRoom(rxbuf)) < (ME_GOAHEAD_LIMIT_BUFFER + 1)) {
         if (!bufGrow(rxbuf, ME_GOAHEAD_LIMIT_BUFFER + 1)) {
             websError(wp, HTTP_CODE_INTERNAL_SERVER_ERROR, "Cannot grow rxbuf");
             websPump(wp);
             return;
         }
+    } else if (wp->lastRead >= room - 1) {
+        /* The last read filled the buffer, so more data is likely waiting. Read in larger blocks. */
+        growBuf(wp, rxbuf);
     }
-    if ((nbytes = websRead(wp, (char*) rxbuf->endp, ME_GOAHEAD_LIMIT_BUFFER)) > 0) {
+    /* Leave room for the trailing null */
+    if ((nbytes = websRead(wp, (char*) rxbuf->endp, bufRoom(rxbuf) - 1)) > 0) {
         wp->lastRead = nbytes;
         bufAdjustEnd(rxbuf, nbytes);
         bufAddNull(rxbuf);
@@ -818,6 +1296,9 @@ static void readEvent(Webs *wp)
             if (wp->state > WEBS_BEGIN) {
                 websError(wp, HTTP_CODE_COMMS_ERROR, "Read error: connection lost");
                 websPump(wp);
+            } else if (bufLen(&wp->output) > 0) {
+                /* Write the responses to pipelined requests before closing */
+                socketCreateHandler(wp->sid, SOCKET_WRITABLE, socketEvent, wp);
             } else {
                 complete(wp, 0);
             }
@@ -838,7 +1319,13 @@ PUBLIC void websPump(Webs *wp)
     for (canProceed = 1; canProceed; ) {
         switch (wp->state) {
         case WEBS_BEGIN:
-            canProceed = parseIncoming(wp);
+            if ((canProceed = parseIncoming(wp)) == 0 && (canProceed = flushPipeline(wp)) == 0) {
+                if (wp->state == WEBS_BEGIN && !(wp->flags & WEBS_CLOSED) && bufLen(&wp->rxbuf) == 0 &&
+                        bufLen(&wp->output) == 0) {
+                    /* Idle keep-alive connection. Hold no buffers until the next request arrives. */
+                    releaseBufs(wp);
+                }
+            }
             break;
         case WEBS_CONTENT:
             canProceed = processContent(wp);
@@ -866,16 +1353,20 @@ PUBLIC void websPump(Webs *wp)
 
 static bool parseIncoming(Webs *wp)
 {
-    WebsBuf     *rxbuf;
-    char        *end, c;
+    WebsBuf         *rxbuf;
+#if ME_GOAHEAD_CGI
+    WebsCgiState    *cgi;
+#endif
+    char            *end, *name, c;
 
     rxbuf = &wp->rxbuf;
     while (*rxbuf->servp == '\r' || *rxbuf->servp == '\n') {
+        wp->rxScanned = 0;
         if (bufGetc(rxbuf) < 0) {
             break;
         }
     }
-    if ((end = strstr((char*) wp->rxbuf.servp, "\r\n\r\n")) == 0) {
+    if ((end = findHeaderEnd(wp)) == 0) {
         if (bufLen(&wp->rxbuf) >= ME_GOAHEAD_LIMIT_HEADER) {
             websError(wp, HTTP_CODE_REQUEST_TOO_LARGE | WEBS_CLOSE, "Header too large");
             return 1;
@@ -895,7 +1386,7 @@ static bool parseIncoming(Webs *wp)
     if (wp->state == WEBS_COMPLETE) {
         return 1;
     }
-    parseHeaders(wp);
+    parseHeaders(wp, end);
     if (wp->state == WEBS_COMPLETE) {
         return 1;
     }
@@ -909,8 +1400,15 @@ static bool parseIncoming(Webs *wp)
 #if ME_GOAHEAD_CGI
     if (wp->route && wp->route->handler && wp->route->handler->service == cgiHandler) {
         if (smatch(wp->method, "POST")) {
-            wp->cgiStdin = websGetCgiCommName();
-            if ((wp->cgifd = open(wp->cgiStdin, O_CREAT | O_WRONLY | O_BINARY | O_TRUNC, 0666)) < 0) {
+            if ((cgi = arenaAlloc(&wp->arena, sizeof(WebsCgiState))) == 0) {
+                websError(wp, HTTP_CODE_INTERNAL_SERVER_ERROR | WEBS_CLOSE, "Cannot allocate CGI state");
+                return 1;
+            }
+            name = websGetCgiCommName();
+            cgi->stdIn = arenaClone(&wp->arena, name);
+            wfree(name);
+            wp->cgiState = cgi;
+            if ((cgi->fd = open(cgi->stdIn, O_CREAT | O_WRONLY | O_BINARY | O_TRUNC, 0666)) < 0) {
                 websError(wp, HTTP_CODE_NOT_FOUND | WEBS_CLOSE, "Cannot open CGI file");
                 return 1;
             }
@@ -921,12 +1419,13 @@ static bool parseIncoming(Webs *wp)
     if (smatch(wp->method, "PUT")) {
         WebsStat    sbuf;
         wp->code = (stat(wp->filename, &sbuf) == 0 && sbuf.st_mode & S_IFDIR) ? HTTP_CODE_NO_CONTENT : HTTP_CODE_CREATED;
-        wfree(wp->putname);
-        wp->putname = websTempFile(ME_GOAHEAD_PUT_DIR, "put");
+        name = websTempFile(ME_GOAHEAD_PUT_DIR, "put");
+        wp->putname = arenaClone(&wp->arena, name);
+        wfree(name);
         if ((wp->putfd = open(wp->putname, O_BINARY | O_WRONLY | O_CREAT | O_BINARY, 0644)) < 0) {
             error("Cannot create PUT filename %s", wp->putname);
             websError(wp, HTTP_CODE_INTERNAL_SERVER_ERROR, "Cannot create the put URI");
-            wfree(wp->putname);
+            wp->putname = 0;
             return 1;
         }
     }
@@ -954,7 +1453,7 @@ static void parseFirstLine(Webs *wp)
         websError(wp, HTTP_CODE_NOT_FOUND | WEBS_CLOSE, "Bad HTTP request");
         return;
     }
-    wp->method = supper(sclone(op));
+    wp->method = supper(arenaClone(&wp->arena, op));
 
     url = getToken(wp, 0);
     if (url == NULL || *url == '\0') {
@@ -981,18 +1480,20 @@ static void parseFirstLine(Webs *wp)
         websError(wp, HTTP_CODE_BAD_REQUEST | WEBS_CLOSE | WEBS_NOLOG, "Bad URL");
         return;
     }
-    if ((wp->path = websValidateUriPath(path)) == 0) {
+    if ((path = websValidateUriPath(path)) == 0) {
         websError(wp, HTTP_CODE_BAD_REQUEST | WEBS_CLOSE | WEBS_NOLOG, "Bad URL");
         wfree(buf);
         return;
     }
-    wp->url = sclone(url);
+    wp->path = arenaClone(&wp->arena, path);
+    wfree(path);
+    wp->url = arenaClone(&wp->arena, url);
     if (ext) {
-        wp->ext = sclone(slower(ext));
+        wp->ext = arenaClone(&wp->arena, slower(ext));
     }
-    wp->filename = sfmt("%s%s", websGetDocuments(), wp->path);
-    wp->query = sclone(query);
-    wp->host = sclone(host);
+    wp->filename = arenaFmt(&wp->arena, "%s%s", websGetDocuments(), wp->path);
+    wp->query = arenaClone(&wp->arena, query);
+    wp->host = arenaClone(&wp->arena, host);
     wp->protocol = wp->flags & WEBS_SECURE ? "https" : "http";
     if (smatch(protoVer, "HTTP/1.1")) {
         wp->flags |= WEBS_KEEP_ALIVE | WEBS_HTTP11;
@@ -1002,7 +1503,7 @@ static void parseFirstLine(Webs *wp)
         protoVer = "HTTP/1.1";
         websError(wp, WEBS_CLOSE | HTTP_CODE_NOT_ACCEPTABLE, "Unsupported HTTP protocol");
     }
-    wp->protoVersion = sclone(protoVer);
+    wp->protoVersion = arenaClone(&wp->arena, protoVer);
     if ((listenPort = socketGetPort(wp->listenSid)) >= 0) {
         wp->port = listenPort;
     } else {
@@ -1013,84 +1514,177 @@ static void parseFirstLine(Webs *wp)
 
 
 /*
-    Parse a full request
+    Map a lower case header key to its known header id with one switch on the key length and first character.
+    Returns WEBS_HDR_OTHER for headers that are not specially handled.
  */
-static void parseHeaders(Webs *wp)
+PUBLIC int websGetHeaderId(cchar *key, ssize len)
 {
-    cchar   *prior;
-    char    *combined, *upperKey, *cp, *key, *value, *tok;
-    int     count;
+    assert(key);
 
-    assert(websValid(wp));
-
-    /*
-        Parse the header and create the Http header keyword variables
-        We rewrite the header as we go for non-local requests.  NOTE: this
-        modifies the header string directly and tokenizes each line with '\0'.
-    */
-    for (count = 0; wp->rxbuf.servp[0] != '\r'; count++) {
-        if (count >= ME_GOAHEAD_LIMIT_NUM_HEADERS) {
-            websError(wp, HTTP_CODE_REQUEST_TOO_LARGE | WEBS_CLOSE, "Too many headers");
-            return;
+    switch (len) {
+    case 4:
+        if (memcmp(key, "host", 4) == 0) {
+            return WEBS_HDR_HOST;
         }
-        if ((key = getToken(wp, ":")) == NULL) {
-            continue;
+        break;
+    case 6:
+        if (memcmp(key, "cookie", 6) == 0) {
+            return WEBS_HDR_COOKIE;
         }
-        if ((value = getToken(wp, "\r\n")) == NULL) {
-            value = "";
+        break;
+    case 7:
+        if (memcmp(key, "referer", 7) == 0) {
+            return WEBS_HDR_REFERER;
         }
-        if (!key || !value) {
-            websError(wp, HTTP_CODE_BAD_REQUEST | WEBS_CLOSE, "Bad header format");
-            return;
+        break;
+    case 10:
+        if (key[0] == 'u') {
+            if (memcmp(key, "user-agent", 10) == 0) {
+                return WEBS_HDR_USER_AGENT;
+            }
+        } else if (key[0] == 'c') {
+            if (memcmp(key, "connection", 10) == 0) {
+                return WEBS_HDR_CONNECTION;
+            }
         }
-        while (isspace((uchar) *value)) {
-            value++;
+        break;
+    case 12:
+        if (memcmp(key, "content-type", 12) == 0) {
+            return WEBS_HDR_CONTENT_TYPE;
         }
-        slower(key);
-
-        /*
-            Create a header variable for each line in the header
-         */
-        upperKey = sfmt("HTTP_%s", key);
-        for (cp = upperKey; *cp; cp++) {
-            if (*cp == '-') {
-                *cp = '_';
+        break;
+    case 13:
+        if (memcmp(key, "authorization", 13) == 0) {
+            return WEBS_HDR_AUTHORIZATION;
+        }
+        break;
+    case 14:
+        if (memcmp(key, "content-length", 14) == 0) {
+            return WEBS_HDR_CONTENT_LENGTH;
+        }
+        break;
+    case 17:
+        if (key[0] == 'i') {
+            if (memcmp(key, "if-modified-since", 17) == 0) {
+                return WEBS_HDR_IF_MODIFIED_SINCE;
+            }
+        } else if (key[0] == 't') {
+            if (memcmp(key, "transfer-encoding", 17) == 0) {
+                return WEBS_HDR_TRANSFER_ENCODING;
             }
         }
-        supper(upperKey);
-        if ((prior = websGetVar(wp, upperKey, 0)) != 0) {
-            combined = sfmt("%s, %s", prior, value);
-            websSetVar(wp, upperKey, combined);
-            wfree(combined);
-        } else {
-            websSetVar(wp, upperKey, value);
+        break;
+    }
+    return WEBS_HDR_OTHER;
+}
+
+
+/*
+    Find the "\r\n\r\n" terminating the request header. The scan resumes where the previous scan of this request
+    stopped, so a header that trickles in over many reads is examined once in total. Each newline is found with memchr
+    which the C library vectorizes on most targets, and then the three preceding bytes are checked.
+ */
+static char *findHeaderEnd(Webs *wp)
+{
+    char    *start, *cp, *endp;
+
+    start = wp->rxbuf.servp;
+    endp = wp->rxbuf.endp;
+    cp = start + wp->rxScanned;
+    while (cp < endp && (cp = memchr(cp, '\n', endp - cp)) != 0) {
+        if ((cp - start) >= 3 && cp[-1] == '\r' && cp[-2] == '\n' && cp[-3] == '\r') {
+            return cp - 3;
         }
-        wfree(upperKey);
+        cp++;
+    }
+    wp->rxScanned = endp - start;
+    return 0;
+}
 
-        /*
-            Track the requesting agent (browser) type
-         */
-        if (strcmp(key, "user-agent") == 0) {
-            wfree(wp->userAgent);
-            wp->userAgent = sclone(value);
 
-        } else if (scaselesscmp(key, "authorization") == 0) {
-            wfree(wp->authType);
-            wp->authType = sclone(value);
-            ssplit(wp->authType, " \t", &tok);
-            wfree(wp->authDetails);
-            wp->authDetails = sclone(tok);
+/*
+    Parse the request headers. The end argument references the "\r\n\r\n" located by findHeaderEnd. The header block
+    is copied once into the request arena and each header is recorded as a key and value slice of that copy.
+    HTTP_* vars are not created here, see websSetHeaderVars.
+ */
+static void parseHeaders(Webs *wp, char *end)
+{
+    WebsHeader  list[ME_GOAHEAD_LIMIT_NUM_HEADERS], *hp;
+    char        *start, *line, *eol, *cp, *key, *value, *tok;
+    ssize       len;
+    int         count;
+
+    assert(websValid(wp));
+
+    start = wp->rxbuf.servp;
+    if (*start == '\r') {
+        end = start;
+        len = 0;
+    } else if (end >= start) {
+        /* Include the "\r\n" terminating the last header */
+        end += 2;
+        len = end - start;
+    } else {
+        websError(wp, HTTP_CODE_BAD_REQUEST | WEBS_CLOSE, "Bad header format");
+        return;
+    }
+    if ((wp->rxHeaders = arenaAlloc(&wp->arena, len + 1)) == 0) {
+        websError(wp, HTTP_CODE_INTERNAL_SERVER_ERROR | WEBS_CLOSE, "Cannot allocate headers");
+        return;
+    }
+    memcpy(wp->rxHeaders, start, len);
+    wp->rxHeaders[len] = '\0';
+    wp->rxbuf.servp = end;
+
+    /*
+        Tokenize each line of the copy with '\0'. Values reference the copy and are not cloned.
+     */
+    for (count = 0, line = wp->rxHeaders; *line; line = eol + 2) {
+        if (count >= ME_GOAHEAD_LIMIT_NUM_HEADERS) {
+            websError(wp, HTTP_CODE_REQUEST_TOO_LARGE | WEBS_CLOSE, "Too many headers");
+            return;
+        }
+        eol = strstr(line, "\r\n");
+        assert(eol);
+        *eol = '\0';
+        key = line;
+        if ((cp = strchr(key, ':')) == 0) {
+            /* Skip malformed lines without a colon */
+            continue;
+        }
+        *cp = '\0';
+        for (value = cp + 1; isspace((uchar) *value); value++) {}
+        slower(key);
+        hp = &list[count++];
+        hp->key = (int) (key - wp->rxHeaders);
+        hp->keyLen = (int) (cp - key);
+        hp->value = (int) (value - wp->rxHeaders);
+        hp->valueLen = (int) (eol - value);
+
+        /*
+            Dispatch known headers via a single lookup of the header id
+         */
+        switch ((hp->id = websGetHeaderId(key, hp->keyLen))) {
+        case WEBS_HDR_USER_AGENT:
+            wp->userAgent = value;
+            break;
+
+        case WEBS_HDR_AUTHORIZATION:
+            wp->authType = arenaClone(&wp->arena, value);
+            ssplit(wp->authType, " \t", &tok);
+            wp->authDetails = tok;
             slower(wp->authType);
+            break;
 
-        } else if (strcmp(key, "connection") == 0) {
-            slower(value);
-            if (strcmp(value, "keep-alive") == 0) {
+        case WEBS_HDR_CONNECTION:
+            if (scaselessmatch(value, "keep-alive")) {
                 wp->flags |= WEBS_KEEP_ALIVE;
-            } else if (strcmp(value, "close") == 0) {
+            } else if (scaselessmatch(value, "close")) {
                 wp->flags &= ~WEBS_KEEP_ALIVE;
             }
+            break;
 
-        } else if (strcmp(key, "content-length") == 0) {
+        case WEBS_HDR_CONTENT_LENGTH:
             if ((wp->rxLen = atoi(value)) < 0) {
                 websError(wp, HTTP_CODE_REQUEST_TOO_LARGE | WEBS_CLOSE, "Invalid content length");
                 return;
@@ -1109,10 +1703,10 @@ static void parseHeaders(Webs *wp)
             if (!smatch(wp->method, "HEAD")) {
                 wp->rxRemaining = wp->rxLen;
             }
+            break;
 
-        } else if (strcmp(key, "content-type") == 0) {
-            wfree(wp->contentType);
-            wp->contentType = sclone(value);
+        case WEBS_HDR_CONTENT_TYPE:
+            wp->contentType = value;
             if (strstr(value, "application/x-www-form-urlencoded")) {
                 wp->flags |= WEBS_FORM;
             } else if (strstr(value, "application/json")) {
@@ -1120,46 +1714,60 @@ static void parseHeaders(Webs *wp)
             } else if (strstr(value, "multipart/form-data")) {
                 wp->flags |= WEBS_UPLOAD;
             }
+            break;
 
-        } else if (strcmp(key, "cookie") == 0) {
+        case WEBS_HDR_COOKIE:
             wp->flags |= WEBS_COOKIE;
             if (wp->cookie) {
-                char *prior = wp->cookie;
-                wp->cookie = sfmt("%s; %s", prior, value);
-                wfree(prior);
+                wp->cookie = arenaFmt(&wp->arena, "%s; %s", wp->cookie, value);
             } else {
-                wp->cookie = sclone(value);
+                wp->cookie = value;
             }
+            break;
 
-        } else if (strcmp(key, "host") == 0) {
+        case WEBS_HDR_HOST:
             if ((int) strspn(value, "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789_-.[]:")
                     < (int) slen(value)) {
                 websError(wp, WEBS_CLOSE | HTTP_CODE_BAD_REQUEST, "Bad host header");
                 return;
             }
-            wfree(wp->host);
-            wp->host = sclone(value);
+            wp->host = value;
+            break;
 
-        } else if (strcmp(key, "if-modified-since") == 0) {
+        case WEBS_HDR_IF_MODIFIED_SINCE:
+            value = arenaClone(&wp->arena, value);
             if ((cp = strchr(value, ';')) != NULL) {
                 *cp = '\0';
             }
             websParseDateTime(&wp->since, value, 0);
+            break;
 
-        /*
-            Yes Veronica, the HTTP spec does misspell Referrer
-         */
-        } else if (strcmp(key, "referer") == 0) {
-            wfree(wp->referrer);
-            wp->referrer = sclone(value);
+        case WEBS_HDR_REFERER:
+            /*
+                Yes Veronica, the HTTP spec does misspell Referrer
+             */
+            wp->referrer = value;
+            break;
 
-        } else if (strcmp(key, "transfer-encoding") == 0) {
+        case WEBS_HDR_TRANSFER_ENCODING:
             if (scaselesscmp(value, "chunked") == 0) {
                 wp->rxChunkState = WEBS_CHUNK_START;
                 wp->rxRemaining = MAXINT;
             }
+            break;
+
+        default:
+            break;
+        }
+    }
+    if (count > 0) {
+        if ((wp->rxHeaderList = arenaAlloc(&wp->arena, count * sizeof(WebsHeader))) == 0) {
+            websError(wp, HTTP_CODE_INTERNAL_SERVER_ERROR | WEBS_CLOSE, "Cannot allocate headers");
+            return;
         }
+        memcpy(wp->rxHeaderList, list, count * sizeof(WebsHeader));
     }
+    wp->rxHeaderCount = count;
     if (!wp->rxChunkState) {
         /*
             Step over "\r\n" after headers.
@@ -1197,7 +1805,7 @@ static bool processContent(Webs *wp)
     }
 #endif
 #if ME_GOAHEAD_CGI
-    if (wp->cgifd >= 0) {
+    if (wp->cgiState && wp->cgiState->fd >= 0) {
         canProceed = websProcessCgiData(wp);
         if (!canProceed || wp->finalized) {
             return canProceed;
@@ -1304,8 +1912,7 @@ static bool filterChunkData(Webs *wp)
             wp->rxRemaining = chunkSize;
             if (chunkSize == 0) {
 #if ME_GOAHEAD_LEGACY
-                wfree(wp->query);
-                wp->query = sclone(bufStart(&wp->input));
+                wp->query = arenaClone(&wp->arena, bufStart(&wp->input));
 #endif
                 wp->eof = 1;
                 return 1;
@@ -1341,25 +1948,151 @@ static bool filterChunkData(Webs *wp)
  */
 PUBLIC void websServiceEvents(int *finished)
 {
-    int     delay, nextEvent;
+    int     delay, nextEvent, ready;
+#if ME_GOAHEAD_STATS
+    WebsLoopStats   *lp;
+    int64           start, mark, now, waited;
 
+    lp = &loopStats;
+#endif
     if (finished) {
         *finished = 0;
     }
     delay = 0;
     while (!finished || !*finished) {
-        if (socketSelect(-1, delay)) {
+#if ME_GOAHEAD_STATS
+        start = websGetHiResTicks();
+#endif
+        ready = socketSelect(-1, delay);
+#if ME_GOAHEAD_STATS
+        mark = websGetHiResTicks();
+        waited = mark - start;
+#endif
+        if (ready) {
             socketProcess();
         }
+#if ME_GOAHEAD_STATS
+        now = websGetHiResTicks();
+        lp->process += now - mark;
+        mark = now;
+#endif
 #if ME_GOAHEAD_CGI
         delay = websCgiPoll();
 #else
         delay = MAXINT;
+#endif
+#if ME_GOAHEAD_STATS
+        now = websGetHiResTicks();
+        lp->cgi += now - mark;
+        mark = now;
 #endif
         nextEvent = websRunEvents();
         delay = min(delay, nextEvent);
+#if ME_GOAHEAD_STATS
+        now = websGetHiResTicks();
+        lp->events += now - mark;
+        lp->iterations++;
+        lp->wait += waited;
+        lp->lastIteration = now - start;
+        lp->elapsed += lp->lastIteration;
+        lp->maxIteration = max(lp->maxIteration, lp->lastIteration);
+        lp->lastLag = lp->lastIteration - waited;
+        lp->maxLag = max(lp->maxLag, lp->lastLag);
+        lp->lastReady = ready;
+        lp->ready += ready;
+        lp->maxReady = max(lp->maxReady, ready);
+#endif
+    }
+}
+
+
+PUBLIC void websGetLoopStats(WebsLoopStats *stats)
+{
+    assert(stats);
+
+#if ME_GOAHEAD_STATS
+    *stats = loopStats;
+    socketGetHandlerStats(&stats->handlers, &stats->handlerTime, &stats->maxHandler, 0);
+#else
+    memset(stats, 0, sizeof(WebsLoopStats));
+#endif
+}
+
+
+PUBLIC void websResetLoopStats()
+{
+#if ME_GOAHEAD_STATS
+    int64   count, elapsed, worst;
+
+    memset(&loopStats, 0, sizeof(WebsLoopStats));
+    loopStats.started = websGetTicks();
+    socketGetHandlerStats(&count, &elapsed, &worst, 1);
+#endif
+}
+
+
+#if ME_GOAHEAD_STATS
+/*
+    Action to return the server statistics as JSON. This is read-only and is only served if defined by the application.
+ */
+PUBLIC void websStatsAction(Webs *wp)
+{
+    WebsLoopStats   stats;
+    int64           hits, misses, requests, allocs;
+    ssize           memory, spare;
+    int             idle, open, idleConns;
+
+    if (!smatch(wp->method, "GET") && !smatch(wp->method, "HEAD")) {
+        websError(wp, HTTP_CODE_BAD_METHOD, "Unsupported method");
+        return;
+    }
+    websGetLoopStats(&stats);
+    websGetPoolStats(&idle, &hits, &misses);
+    websGetRequestStats(&requests, &allocs);
+    websGetConnStats(&open, &idleConns, &memory, &spare);
+    websSetStatus(wp, 200);
+    websWriteHeaders(wp, -1, 0);
+    websWriteHeader(wp, "Content-Type", "application/json");
+    websWriteHeader(wp, "Cache-Control", "no-cache");
+    websWriteEndHeaders(wp);
+    if (!smatch(wp->method, "HEAD")) {
+        websWrite(wp, "{\n  \"loop\": {\n");
+        websWrite(wp, "    \"uptime\": %Ld,\n", websGetTicks() - stats.started);
+        websWrite(wp, "    \"iterations\": %Ld,\n", stats.iterations);
+        websWrite(wp, "    \"elapsed\": %Ld,\n", stats.elapsed);
+        websWrite(wp, "    \"wait\": %Ld,\n", stats.wait);
+        websWrite(wp, "    \"process\": %Ld,\n", stats.process);
+        websWrite(wp, "    \"cgi\": %Ld,\n", stats.cgi);
+        websWrite(wp, "    \"events\": %Ld,\n", stats.events);
+        websWrite(wp, "    \"lastIteration\": %Ld,\n", stats.lastIteration);
+        websWrite(wp, "    \"maxIteration\": %Ld,\n", stats.maxIteration);
+        websWrite(wp, "    \"lastLag\": %Ld,\n", stats.lastLag);
+        websWrite(wp, "    \"maxLag\": %Ld,\n", stats.maxLag);
+        websWrite(wp, "    \"ready\": %Ld,\n", stats.ready);
+        websWrite(wp, "    \"lastReady\": %d,\n", stats.lastReady);
+        websWrite(wp, "    \"maxReady\": %d,\n", stats.maxReady);
+        websWrite(wp, "    \"handlers\": %Ld,\n", stats.handlers);
+        websWrite(wp, "    \"handlerTime\": %Ld,\n", stats.handlerTime);
+        websWrite(wp, "    \"maxHandler\": %Ld\n", stats.maxHandler);
+        websWrite(wp, "  },\n  \"pool\": {\n");
+        websWrite(wp, "    \"limit\": %d,\n", ME_GOAHEAD_LIMIT_POOL);
+        websWrite(wp, "    \"idle\": %d,\n", idle);
+        websWrite(wp, "    \"hits\": %Ld,\n", hits);
+        websWrite(wp, "    \"misses\": %Ld\n", misses);
+        websWrite(wp, "  },\n  \"requests\": {\n");
+        websWrite(wp, "    \"count\": %Ld,\n", requests);
+        websWrite(wp, "    \"allocations\": %Ld\n", allocs);
+        websWrite(wp, "  },\n  \"connections\": {\n");
+        websWrite(wp, "    \"open\": %d,\n", open);
+        websWrite(wp, "    \"idle\": %d,\n", idleConns);
+        websWrite(wp, "    \"memory\": %Ld,\n", (int64) memory);
+        websWrite(wp, "    \"idleSize\": %d,\n", (int) (sizeof(Webs) + sizeof(WebsSocket)));
+        websWrite(wp, "    \"spareMemory\": %Ld\n", (int64) spare);
+        websWrite(wp, "  }\n}\n");
     }
+    websDone(wp);
 }
+#endif
 
 
 /*
@@ -1406,32 +2139,128 @@ static void addFormVars(Webs *wp, char *vars)
  */
 PUBLIC void websSetEnv(Webs *wp)
 {
+    cchar   **name, *value;
+
     assert(wp);
     assert(websValid(wp));
 
-    websSetVar(wp, "AUTH_TYPE", wp->authType);
-    websSetVarFmt(wp, "CONTENT_LENGTH", "%d", wp->rxLen);
-    websSetVar(wp, "CONTENT_TYPE", wp->contentType);
-    if (wp->route && wp->route->dir) {
-        websSetVar(wp, "DOCUMENT_ROOT", wp->route->dir);
+    websSetHeaderVars(wp);
+    for (name = envVars; *name; name++) {
+        if ((value = getEnvVar(wp, *name)) != 0) {
+            websSetVar(wp, *name, value);
+        }
+    }
+}
+
+
+/*
+    Return the value of a standard CGI variable from the request. Returns null if var is not a CGI variable or is not
+    defined for this request. The cases are in envVars order.
+ */
+static cchar *getEnvVar(Webs *wp, cchar *var)
+{
+    cchar   **name, *value;
+
+    if (!isupper((uchar) *var)) {
+        return 0;
+    }
+    for (name = envVars; *name; name++) {
+        if (strcmp(var, *name) == 0) {
+            break;
+        }
+    }
+    switch (name - envVars) {
+    case 0:  value = wp->authType; break;
+    case 1:  value = arenaFmt(&wp->arena, "%d", (int) wp->rxLen); break;
+    case 2:  value = wp->contentType; break;
+    case 3:  return (wp->route && wp->route->dir) ? wp->route->dir : 0;
+    case 4:  value = "CGI/1.1"; break;
+    case 5:  value = wp->path; break;
+    case 6:  value = wp->filename; break;
+    case 7:  value = wp->query; break;
+    case 8:  value = wp->ipaddr; break;
+    case 9:  value = wp->username; break;
+    case 10: value = wp->ipaddr; break;
+    case 11: value = wp->method; break;
+    case 12: value = wp->protocol; break;
+    case 13: value = wp->path; break;
+    case 14: value = wp->ifaddr; break;
+    case 15: value = websHost; break;
+    case 16: value = websHost; break;
+    case 17: value = arenaFmt(&wp->arena, "%d", wp->port); break;
+    case 18: value = wp->protoVersion; break;
+    case 19: value = websHostUrl; break;
+    case 20: value = "GoAhead/" ME_VERSION; break;
+    default: return 0;
+    }
+    return value ? value : "";
+}
+
+
+/*
+    Return the vars hash, creating it on first use
+ */
+static WebsHash getVars(Webs *wp)
+{
+    if (wp->vars < 0) {
+        wp->vars = hashCreate(WEBS_HASH_INIT);
+    }
+    return wp->vars;
+}
+
+
+/*
+    Create the HTTP_* vars from the request header slices. Vars already defined are not overwritten.
+ */
+PUBLIC void websSetHeaderVars(Webs *wp)
+{
+    WebsHeader  *hp, *dp;
+    WebsValue   v;
+    char        *name, *value, *cp;
+    int         i, j;
+
+    assert(websValid(wp));
+
+    getVars(wp);
+    if ((wp->flags & WEBS_HEADER_VARS) || wp->rxHeaders == 0) {
+        /* Already defined or the headers are not yet parsed */
+        return;
+    }
+    wp->flags |= WEBS_HEADER_VARS;
+
+    for (i = 0; i < wp->rxHeaderCount; i++) {
+        hp = &wp->rxHeaderList[i];
+        for (j = 0; j < i; j++) {
+            dp = &wp->rxHeaderList[j];
+            if (dp->keyLen == hp->keyLen && strcmp(&wp->rxHeaders[dp->key], &wp->rxHeaders[hp->key]) == 0) {
+                break;
+            }
+        }
+        if (j < i) {
+            /* Already joined with the first occurrence */
+            continue;
+        }
+        if ((name = arenaAlloc(&wp->arena, hp->keyLen + 6)) == 0) {
+            return;
+        }
+        memcpy(name, "HTTP_", 5);
+        for (cp = &name[5], j = 0; j < hp->keyLen; j++) {
+            *cp++ = (wp->rxHeaders[hp->key + j] == '-') ? '_' : toupper((uchar) wp->rxHeaders[hp->key + j]);
+        }
+        *cp = '\0';
+        if (hashLookup(wp->vars, name)) {
+            continue;
+        }
+        value = &wp->rxHeaders[hp->value];
+        for (j = i + 1; j < wp->rxHeaderCount; j++) {
+            dp = &wp->rxHeaderList[j];
+            if (dp->keyLen == hp->keyLen && strcmp(&wp->rxHeaders[dp->key], &wp->rxHeaders[hp->key]) == 0) {
+                value = arenaFmt(&wp->arena, "%s, %s", value, &wp->rxHeaders[dp->value]);
+            }
+        }
+        v = valueString(value, 0);
+        hashEnter(wp->vars, name, v, 0);
     }
-    websSetVar(wp, "GATEWAY_INTERFACE", "CGI/1.1");
-    websSetVar(wp, "PATH_INFO", wp->path);
-    websSetVar(wp, "PATH_TRANSLATED", wp->filename);
-    websSetVar(wp, "QUERY_STRING", wp->query);
-    websSetVar(wp, "REMOTE_ADDR", wp->ipaddr);
-    websSetVar(wp, "REMOTE_USER", wp->username);
-    websSetVar(wp, "REMOTE_HOST", wp->ipaddr);
-    websSetVar(wp, "REQUEST_METHOD", wp->method);
-    websSetVar(wp, "REQUEST_TRANSPORT", wp->protocol);
-    websSetVar(wp, "REQUEST_URI", wp->path);
-    websSetVar(wp, "SERVER_ADDR", wp->ifaddr);
-    websSetVar(wp, "SERVER_HOST", websHost);
-    websSetVar(wp, "SERVER_NAME", websHost);
-    websSetVarFmt(wp, "SERVER_PORT", "%d", wp->port);
-    websSetVar(wp, "SERVER_PROTOCOL", wp->protoVersion);
-    websSetVar(wp, "SERVER_URL", websHostUrl);
-    websSetVarFmt(wp, "SERVER_SOFTWARE", "GoAhead/%s", ME_VERSION);
 }
 
 
@@ -1441,9 +2270,8 @@ PUBLIC void websSetFormVars(Webs *wp)
 
     if (wp->rxLen > 0 && bufLen(&wp->input) > 0) {
         if (wp->flags & WEBS_FORM) {
-            data = sclone(wp->input.servp);
+            data = arenaClone(&wp->arena, wp->input.servp);
             addFormVars(wp, data);
-            wfree(data);
         }
     }
 }
@@ -1456,8 +2284,7 @@ PUBLIC void websSetQueryVars(Webs *wp)
         split pairs at the '='.  Note: we rely on wp->decodedQuery preserving the decoded values in the symbol table.
      */
     if (wp->query && *wp->query) {
-        wfree(wp->decodedQuery);
-        wp->decodedQuery = sclone(wp->query);
+        wp->decodedQuery = arenaClone(&wp->arena, wp->query);
         addFormVars(wp, wp->decodedQuery);
     }
 }
@@ -1477,13 +2304,12 @@ PUBLIC WebsKey *websSetVarFmt(Webs *wp, cchar *var, cchar *fmt, ...)
 
     if (fmt) {
         va_start(args, fmt);
-        v = valueString(sfmtv(fmt, args), 0);
-        v.allocated = 1;
+        v = valueString(arenaFmtv(&wp->arena, fmt, args), 0);
         va_end(args);
     } else {
         v = valueString("", 0);
     }
-    return hashEnter(wp->vars, var, v, 0);
+    return hashEnter(getVars(wp), var, v, 0);
 }
 
 
@@ -1495,11 +2321,11 @@ PUBLIC WebsKey *websSetVar(Webs *wp, cchar *var, cchar *value)
     assert(var && *var);
 
     if (value) {
-        v = valueString(value, VALUE_ALLOCATE);
+        v = valueString(arenaClone(&wp->arena, value), 0);
     } else {
         v = valueString("", 0);
     }
-    return hashEnter(wp->vars, var, v, 0);
+    return hashEnter(getVars(wp), var, v, 0);
 }
 
 
@@ -1516,8 +2342,12 @@ PUBLIC bool websTestVar(Webs *wp, cchar *var)
     if (var == NULL || *var == '\0') {
         return 0;
     }
-    if ((sp = hashLookup(wp->vars, var)) == NULL) {
-        return 0;
+    if (wp->vars < 0 || (sp = hashLookup(wp->vars, var)) == NULL) {
+        if (!(wp->flags & WEBS_HEADER_VARS) && sncmp(var, "HTTP_", 5) == 0) {
+            websSetHeaderVars(wp);
+            return websTestVar(wp, var);
+        }
+        return getEnvVar(wp, var) != 0;
     }
     return 1;
 }
@@ -1530,11 +2360,12 @@ PUBLIC bool websTestVar(Webs *wp, cchar *var)
 PUBLIC cchar *websGetVar(Webs *wp, cchar *var, cchar *defaultGetValue)
 {
     WebsKey   *sp;
+    cchar     *value;
 
     assert(websValid(wp));
     assert(var && *var);
 
-    if ((sp = hashLookup(wp->vars, var)) != NULL) {
+    if (wp->vars >= 0 && (sp = hashLookup(wp->vars, var)) != NULL) {
         assert(sp->content.type == string);
         if (sp->content.value.string) {
             return sp->content.value.string;
@@ -1542,6 +2373,13 @@ PUBLIC cchar *websGetVar(Webs *wp, cchar *var, cchar *defaultGetValue)
             return "";
         }
     }
+    if (!(wp->flags & WEBS_HEADER_VARS) && sncmp(var, "HTTP_", 5) == 0) {
+        websSetHeaderVars(wp);
+        return websGetVar(wp, var, defaultGetValue);
+    }
+    if ((value = getEnvVar(wp, var)) != 0) {
+        return value;
+    }
     return defaultGetValue;
 }
 
@@ -1813,6 +2651,140 @@ PUBLIC int websWriteHeader(Webs *wp, cchar *key, cchar *fmt, ...)
 }
 
 
+/*
+    Write a header with a literal value. The value is not formatted or copied.
+ */
+static int writeHeaderValue(Webs *wp, cchar *key, cchar *value)
+{
+    assert(websValid(wp));
+    assert(key && value);
+
+    if (!(wp->flags & WEBS_RESPONSE_TRACED)) {
+        wp->flags |= WEBS_RESPONSE_TRACED;
+        trace(3 | WEBS_RAW_MSG, "\n>>> Response\n");
+    }
+    trace(3 | WEBS_RAW_MSG, "%s: %s\r\n", key, value);
+    if (websWriteBlock(wp, key, strlen(key)) < 0 || websWriteBlock(wp, ": ", 2) < 0 ||
+            websWriteBlock(wp, value, strlen(value)) < 0 || websWriteBlock(wp, "\r\n", 2) != 2) {
+        return -1;
+    }
+    return 0;
+}
+
+
+/*
+    Write pre-rendered header text
+ */
+static int writeHeaderText(Webs *wp, cchar *text, ssize len)
+{
+    assert(websValid(wp));
+
+    if (!(wp->flags & WEBS_RESPONSE_TRACED)) {
+        wp->flags |= WEBS_RESPONSE_TRACED;
+        trace(3 | WEBS_RAW_MSG, "\n>>> Response\n");
+    }
+    if (len <= 0) {
+        return 0;
+    }
+    trace(3 | WEBS_RAW_MSG, "%.*s", (int) len, text);
+    if (websWriteBlock(wp, text, len) < 0) {
+        return -1;
+    }
+    return 0;
+}
+
+
+/*
+    Test if responses for an extension should be cached by the client
+ */
+static bool clientCache(cchar *ext)
+{
+#if defined(ME_GOAHEAD_CLIENT_CACHE)
+    char    etok[WEBS_TEMPLATE_EXT + 2];
+
+    if (ext && *ext) {
+        fmt(etok, sizeof(etok), "%s,", &ext[1]);
+        return strstr(ME_GOAHEAD_CLIENT_CACHE ",", etok) != 0;
+    }
+#endif
+    return 0;
+}
+
+
+/*
+    Render the response headers that do not vary per request for a protocol, status code and extension
+ */
+static HeaderTemplate *createHeaderTemplate(cchar *protoVersion, int code, cchar *ext)
+{
+    HeaderTemplate  *tp;
+    WebsKey         *key;
+    char            buf[ME_GOAHEAD_LIMIT_BUFFER];
+    ssize           len, statusLen, typeEnd;
+
+    fmt(buf, sizeof(buf), "%s %d %s\r\n", protoVersion, code, websErrorMsg(code));
+    len = slen(buf);
+#if !ME_GOAHEAD_STEALTH
+    len += slen(fmt(&buf[len], sizeof(buf) - len, "Server: GoAhead-http\r\n"));
+#endif
+    statusLen = len;
+    if (*ext && (key = hashLookup(websMime, ext)) != 0) {
+        len += slen(fmt(&buf[len], sizeof(buf) - len, "Content-Type: %s\r\n", key->content.value.string));
+    }
+    typeEnd = len;
+#if defined(ME_GOAHEAD_CLIENT_CACHE)
+    if (*ext && clientCache(ext)) {
+        len += slen(fmt(&buf[len], sizeof(buf) - len, "Cache-Control: public, max-age=%d\r\n",
+            ME_GOAHEAD_CLIENT_CACHE_LIFESPAN));
+    }
+#endif
+#ifdef ME_GOAHEAD_XFRAME_HEADER
+    if (*ME_GOAHEAD_XFRAME_HEADER) {
+        len += slen(fmt(&buf[len], sizeof(buf) - len, "X-Frame-Options: %s\r\n", ME_GOAHEAD_XFRAME_HEADER));
+    }
+#endif
+    if ((tp = walloc(sizeof(HeaderTemplate) + len)) == 0) {
+        return 0;
+    }
+    tp->statusLen = statusLen;
+    tp->typeEnd = typeEnd;
+    tp->len = len;
+    memcpy(tp->text, buf, len + 1);
+    return tp;
+}
+
+
+/*
+    Return the pre-rendered headers for a response. Templates are created on first use. Extensions without a mime type
+    or client cache entry share the template without an extension, so the number of templates is bounded by the
+    mime table and the status codes in use.
+ */
+static HeaderTemplate *getHeaderTemplate(Webs *wp, cchar *protoVersion)
+{
+    HeaderTemplate  *tp;
+    WebsKey         *key;
+    cchar           *ext;
+    char            name[64];
+
+    ext = (wp->ext && slen(wp->ext) <= WEBS_TEMPLATE_EXT) ? wp->ext : "";
+    fmt(name, sizeof(name), "%s %d %s", protoVersion, wp->code, ext);
+    if ((key = hashLookup(headerTemplates, name)) != 0) {
+        return key->content.value.symbol;
+    }
+    if (*ext && !hashLookup(websMime, ext) && !clientCache(ext)) {
+        ext = "";
+        fmt(name, sizeof(name), "%s %d ", protoVersion, wp->code);
+        if ((key = hashLookup(headerTemplates, name)) != 0) {
+            return key->content.value.symbol;
+        }
+    }
+    if ((tp = createHeaderTemplate(protoVersion, wp->code, ext)) == 0) {
+        return 0;
+    }
+    hashEnter(headerTemplates, name, valueSymbol(tp), 0);
+    return tp;
+}
+
+
 PUBLIC void websSetStatus(Webs *wp, int code)
 {
     wp->code = (code & WEBS_CODE_MASK);
@@ -1828,8 +2800,8 @@ PUBLIC void websSetStatus(Webs *wp, int code)
  */
 PUBLIC void websWriteHeaders(Webs *wp, ssize length, cchar *location)
 {
-    WebsKey     *key;
-    char        *date, *protoVersion;
+    HeaderTemplate  *tp;
+    char            *protoVersion, num[32];
 
     assert(websValid(wp));
 
@@ -1839,57 +2811,41 @@ PUBLIC void websWriteHeaders(Webs *wp, ssize length, cchar *location)
             protoVersion = "HTTP/1.0";
             wp->flags &= ~WEBS_KEEP_ALIVE;
         }
-        websWriteHeader(wp, NULL, "%s %d %s", protoVersion, wp->code, websErrorMsg(wp->code));
-#if !ME_GOAHEAD_STEALTH
-        websWriteHeader(wp, "Server", "GoAhead-http");
-#endif
-        if ((date = websGetDateString(NULL)) != NULL) {
-            websWriteHeader(wp, "Date", "%s", date);
-            wfree(date);
+        /*
+            The constant headers come from a pre-rendered template. Only the per-response headers are written here.
+         */
+        if ((tp = getHeaderTemplate(wp, protoVersion)) == 0) {
+            error("Cannot create response headers");
+            return;
         }
+        writeHeaderText(wp, tp->text, tp->statusLen);
+        writeHeaderValue(wp, "Date", websGetDate());
         if (wp->authResponse) {
             websWriteHeader(wp, "WWW-Authenticate", "%s", wp->authResponse);
         }
         if (length >= 0) {
             if (smatch(wp->method, "HEAD")) {
-                websWriteHeader(wp, "Content-Length", "%d", (int) length);
+                writeHeaderValue(wp, "Content-Length", itosbuf(num, sizeof(num), length, 10));
             } else if (!((100 <= wp->code && wp->code <= 199) || wp->code == 204 || wp->code == 304)) {
                 /* Server must not emit a content length header for 1XX, 204 and 304 status */
-                websWriteHeader(wp, "Content-Length", "%d", (int) length);
+                writeHeaderValue(wp, "Content-Length", itosbuf(num, sizeof(num), length, 10));
             }
         }
         wp->txLen = length;
         if (wp->txLen < 0) {
-            websWriteHeader(wp, "Transfer-Encoding", "chunked");
-        }
-        if (wp->flags & WEBS_KEEP_ALIVE) {
-            websWriteHeader(wp, "Connection", "keep-alive");
-        } else {
-            websWriteHeader(wp, "Connection", "close");
+            writeHeaderValue(wp, "Transfer-Encoding", "chunked");
         }
+        writeHeaderValue(wp, "Connection", (wp->flags & WEBS_KEEP_ALIVE) ? "keep-alive" : "close");
         if (location) {
             websWriteHeader(wp, "Location", "%s", location);
-        } else if ((key = hashLookup(websMime, wp->ext)) != 0) {
-            websWriteHeader(wp, "Content-Type", "%s", key->content.value.string);
+        } else {
+            writeHeaderText(wp, &tp->text[tp->statusLen], tp->typeEnd - tp->statusLen);
         }
         if (wp->responseCookie) {
             websWriteHeader(wp, "Set-Cookie", "%s", wp->responseCookie);
             websWriteHeader(wp, "Cache-Control", "%s", "no-cache=\"set-cookie\"");
         }
-#if defined(ME_GOAHEAD_CLIENT_CACHE)
-        if (wp->ext) {
-            char *etok = sfmt("%s,", &wp->ext[1]);
-            if (strstr(ME_GOAHEAD_CLIENT_CACHE ",", etok)) {
-                websWriteHeader(wp, "Cache-Control", "public, max-age=%d", ME_GOAHEAD_CLIENT_CACHE_LIFESPAN);
-            }
-            wfree(etok);
-        }
-#endif
-#ifdef ME_GOAHEAD_XFRAME_HEADER
-        if (*ME_GOAHEAD_XFRAME_HEADER) {
-            websWriteHeader(wp, "X-Frame-Options", "%s", ME_GOAHEAD_XFRAME_HEADER);
-        }
-#endif
+        writeHeaderText(wp, &tp->text[tp->typeEnd], tp->len - tp->typeEnd);
     }
 }
 
@@ -1922,15 +2878,32 @@ PUBLIC void websSetTxLength(Webs *wp, ssize length)
  */
 PUBLIC ssize websWrite(Webs *wp, cchar *fmt, ...)
 {
-    va_list     vargs;
+    va_list     vargs, copy;
+    WebsBuf     *op;
     char        *buf;
-    ssize       rc;
+    ssize       rc, room, len;
 
     assert(websValid(wp));
     assert(fmt && *fmt);
 
     va_start(vargs, fmt);
-
+    op = &wp->output;
+    if (wp->state < WEBS_COMPLETE && !wp->txBlock && (room = outputRoom(wp)) > 1) {
+        /*
+            Format in place into the free space of the output buffer. If the result may have been truncated,
+            format again into a temporary buffer below.
+         */
+        va_copy(copy, vargs);
+        fmtv(op->endp, room, fmt, copy);
+        va_end(copy);
+        len = slen(op->endp);
+        if (len < room - 1) {
+            va_end(vargs);
+            bufAdjustEnd(op, len);
+            return len;
+        }
+        *op->endp = '\0';
+    }
     buf = NULL;
     rc = 0;
     if ((buf = sfmtv(fmt, vargs)) == 0) {
@@ -1942,105 +2915,242 @@ PUBLIC ssize websWrite(Webs *wp, cchar *fmt, ...)
         rc = websWriteBlock(wp, buf, strlen(buf));
         wfree(buf);
     }
-    return rc;
+    return rc;
+}
+
+
+/*
+    Non-blocking write to socket.
+    Returns number of bytes written. Returns -1 on errors. May return short.
+ */
+PUBLIC ssize websWriteSocket(Webs *wp, cchar *buf, ssize size)
+{
+    ssize   written;
+
+    assert(wp);
+    assert(buf);
+    assert(size >= 0);
+
+    if (wp->flags & WEBS_CLOSED) {
+        return -1;
+    }
+#if ME_COM_SSL
+    if (wp->flags & WEBS_SECURE) {
+        if ((written = sslWrite(wp, (void*) buf, size)) < 0) {
+            return written;
+        }
+    } else
+#endif
+    if ((written = socketWrite(wp->sid, (void*) buf, size)) < 0) {
+        return written;
+    }
+    wp->written += written;
+    websNoteRequestActivity(wp);
+    return written;
+}
+
+
+/*
+    Non-blocking gathered write to socket.
+    Returns number of bytes written. Returns -1 on errors. May return short.
+ */
+PUBLIC ssize websWriteSocketVector(Webs *wp, WebsIOVec *iov, int count, bool more)
+{
+    ssize   written;
+#if ME_COM_SSL
+    ssize   len;
+    int     i;
+#endif
+
+    assert(wp);
+    assert(iov);
+    assert(0 <= count && count <= WEBS_MAX_IOVEC);
+
+    if (wp->flags & WEBS_CLOSED) {
+        return -1;
+    }
+#if ME_COM_SSL
+    if (wp->flags & WEBS_SECURE) {
+        for (written = 0, i = 0; i < count; i++) {
+            if ((len = sslWrite(wp, iov[i].start, iov[i].len)) < 0) {
+                if (written == 0) {
+                    return len;
+                }
+                break;
+            }
+            written += len;
+            if (len < iov[i].len) {
+                break;
+            }
+        }
+    } else
+#endif
+    if ((written = socketWriteVector(wp->sid, iov, count, more)) < 0) {
+        return written;
+    }
+    wp->written += written;
+    websNoteRequestActivity(wp);
+    return written;
+}
+
+
+/*
+    Grow a connection buffer up to WEBS_BUFFER_MAX. The first growth of the output buffers goes directly to the size
+    suited to recent responses on this connection. Otherwise the buffer is doubled.
+ */
+static bool growBuf(Webs *wp, WebsBuf *bp)
+{
+    ssize   size;
+
+    if (bp->buflen >= WEBS_BUFFER_MAX) {
+        return 0;
+    }
+    size = bp->buflen * 2;
+    if (bp != &wp->rxbuf) {
+        size = max(size, wp->txBufSize);
+    }
+    size = min(size, WEBS_BUFFER_MAX);
+    return bufGrow(bp, size - bp->buflen);
+}
+
+
+/*
+    Write the output buffer followed by any transferred block with a single gathered write.
+    Returns the number of bytes written or a negative error code.
+ */
+static ssize writeOutput(Webs *wp, bool more)
+{
+    WebsIOVec   iov[3];
+    WebsBuf     *op;
+    ssize       written, len;
+    int         count;
+
+    op = &wp->output;
+    count = 0;
+    if ((len = bufLen(op)) > 0) {
+        iov[count].start = op->servp;
+        iov[count].len = bufGetBlkMax(op);
+        if (iov[count].len < len) {
+            /* Wrapped ring buffer */
+            count++;
+            iov[count].start = op->buf;
+            iov[count].len = len - iov[count - 1].len;
+        }
+        count++;
+    }
+    if (wp->txBlockLen > 0) {
+        iov[count].start = wp->txBlockNext;
+        iov[count].len = wp->txBlockLen;
+        count++;
+    }
+    if (count == 0 || (written = websWriteSocketVector(wp, iov, count, more)) <= 0) {
+        return count == 0 ? 0 : written;
+    }
+    if (len > 0) {
+        len = min(len, written);
+        bufAdjustStart(op, len);
+        bufCompact(op);
+    }
+    if ((len = written - len) > 0) {
+        wp->txBlockNext += len;
+        wp->txBlockLen -= len;
+        if (wp->txBlockLen <= 0) {
+            freeTxBlock(wp);
+        }
+    }
+    return written;
+}
+
+
+static void freeTxBlock(Webs *wp)
+{
+    wfree(wp->txBlock);
+    wp->txBlock = wp->txBlockNext = 0;
+    wp->txBlockLen = 0;
+}
+
+
+/*
+    Move the unwritten part of a transferred block into the output buffer so that subsequent output can be buffered
+    after it. Returns true if the block has been fully moved.
+ */
+static bool spillTxBlock(Webs *wp)
+{
+    ssize   len;
+
+    len = bufPutBlk(&wp->output, wp->txBlockNext, wp->txBlockLen);
+    bufAddNull(&wp->output);
+    wp->txBlockNext += len;
+    wp->txBlockLen -= len;
+    if (wp->txBlockLen <= 0) {
+        freeTxBlock(wp);
+        return 1;
+    }
+    return 0;
 }
 
 
 /*
-    Non-blocking write to socket.
-    Returns number of bytes written. Returns -1 on errors. May return short.
+    Return the room in the output buffer for response data. If chunking, a chunk is opened by reserving room for its
+    prefix ahead of the data. The chunk size is filled in by closeChunk, so chunk data is written once into the output
+    buffer and framed in place. Returns zero if there is not room for a reasonable size chunk.
  */
-PUBLIC ssize websWriteSocket(Webs *wp, cchar *buf, ssize size)
+static ssize outputRoom(Webs *wp)
 {
-    ssize   written;
-
-    assert(wp);
-    assert(buf);
-    assert(size >= 0);
+    WebsBuf     *op;
+    ssize       room;
 
-    if (wp->flags & WEBS_CLOSED) {
-        return -1;
+    op = &wp->output;
+    room = bufRoom(op);
+    if (!(wp->flags & WEBS_CHUNKING) || wp->txChunkState == WEBS_CHUNK_DATA) {
+        return room;
     }
-#if ME_COM_SSL
-    if (wp->flags & WEBS_SECURE) {
-        if ((written = sslWrite(wp, (void*) buf, size)) < 0) {
-            return written;
-        }
-    } else
-#endif
-    if ((written = socketWrite(wp->sid, (void*) buf, size)) < 0) {
-        return written;
+    if (room <= CHUNK_DIGITS + 4 + CHUNK_LOW) {
+        return 0;
     }
-    wp->written += written;
-    websNoteRequestActivity(wp);
-    return written;
+    wp->txChunkStart = bufLen(op);
+    bufPutBlk(op, CHUNK_PREFIX, CHUNK_DIGITS + 4);
+    wp->txChunkState = WEBS_CHUNK_DATA;
+    return bufRoom(op);
 }
 
 
 /*
-    Write some output using transfer chunk encoding if required.
-    Returns true if all the data was written. Otherwise return zero.
+    Close the open chunk by writing its size into the reserved prefix. The size is padded with leading zeros to fill
+    the prefix. The prefix of an empty chunk is removed as a zero size chunk would end the response.
  */
-static bool flushChunkData(Webs *wp)
+static void closeChunk(Webs *wp)
 {
-    ssize   len, written, room;
-
-    assert(wp);
+    WebsBuf     *op;
+    char        *cp;
+    ssize       len;
+    int         i;
 
-    while (bufLen(&wp->chunkbuf) > 0) {
-        /*
-            Stop if there is not room for a reasonable size chunk.
-            Subtract 16 to allow for the final trailer.
-         */
-        if ((room = bufRoom(&wp->output) - 16) <= CHUNK_LOW) {
-            bufGrow(&wp->output, CHUNK_LOW - room + 1);
-            if ((room = bufRoom(&wp->output) - 16) <= CHUNK_LOW) {
-                return 0;
-            }
+    if (wp->txChunkState != WEBS_CHUNK_DATA) {
+        return;
+    }
+    wp->txChunkState = WEBS_CHUNK_START;
+    op = &wp->output;
+    if ((len = bufLen(op) - wp->txChunkStart - CHUNK_DIGITS - 4) < 0) {
+        /* Output discarded */
+        return;
+    }
+    if (len == 0) {
+        op->endp -= CHUNK_DIGITS + 4;
+        if (op->endp < op->buf) {
+            op->endp += op->buflen;
         }
-        switch (wp->txChunkState) {
-        default:
-        case WEBS_CHUNK_START:
-            /* Select the chunk size so that both the prefix and data will fit */
-            wp->txChunkLen = min(bufLen(&wp->chunkbuf), room - 16);
-            fmt(wp->txChunkPrefix, sizeof(wp->txChunkPrefix), "\r\n%x\r\n", wp->txChunkLen);
-            wp->txChunkPrefixLen = slen(wp->txChunkPrefix);
-            wp->txChunkPrefixNext = wp->txChunkPrefix;
-            wp->txChunkState = WEBS_CHUNK_HEADER;
-            break;
-
-        case WEBS_CHUNK_HEADER:
-            if ((written = bufPutBlk(&wp->output, wp->txChunkPrefixNext, wp->txChunkPrefixLen)) < 0) {
-                return 0;
-            } else {
-                wp->txChunkPrefixNext += written;
-                wp->txChunkPrefixLen -= written;
-                if (wp->txChunkPrefixLen <= 0) {
-                    wp->txChunkState = WEBS_CHUNK_DATA;
-                } else {
-                    return 0;
-                }
-            }
-            break;
-
-        case WEBS_CHUNK_DATA:
-            if (wp->txChunkLen > 0) {
-                len = min(room, wp->txChunkLen);
-                if ((written = bufPutBlk(&wp->output, wp->chunkbuf.servp, len)) != len) {
-                    assert(0);
-                    return -1;
-                }
-                bufAdjustStart(&wp->chunkbuf, written);
-                wp->txChunkLen -= written;
-                if (wp->txChunkLen <= 0) {
-                    wp->txChunkState = WEBS_CHUNK_START;
-                    bufCompact(&wp->chunkbuf);
-                }
-                bufAddNull(&wp->output);
-            }
+        bufAddNull(op);
+        return;
+    }
+    for (i = CHUNK_DIGITS + 1; i >= 2; i--) {
+        cp = op->servp + wp->txChunkStart + i;
+        if (cp >= op->endbuf) {
+            cp -= op->buflen;
         }
+        *cp = "0123456789abcdef"[len & 0xF];
+        len >>= 4;
     }
-    return bufLen(&wp->chunkbuf) == 0;
 }
 
 
@@ -2051,6 +3161,16 @@ static bool flushChunkData(Webs *wp)
             == 1 if the output was fully written to the socket
  */
 PUBLIC int websFlush(Webs *wp, bool block)
+{
+    return flushOutput(wp, block, 0);
+}
+
+
+/*
+    Flush the output buffer. Set "more" if more response data will follow so a corked socket can coalesce the
+    trailing partial segment with that data. Otherwise, data held back by a prior corked write is pushed.
+ */
+static int flushOutput(Webs *wp, bool block, bool more)
 {
     WebsBuf     *op;
     ssize       nbytes, written;
@@ -2060,19 +3180,26 @@ PUBLIC int websFlush(Webs *wp, bool block)
         wasBlocking = socketSetBlock(wp->sid, 1);
     }
     op = &wp->output;
-    if (wp->flags & WEBS_CHUNKING) {
-        trace(6, "websFlush chunking finalized %d", wp->finalized);
-        if (flushChunkData(wp) && wp->finalized) {
-            trace(6, "websFlush: write chunk trailer");
-            bufPutStr(op, "\r\n0\r\n\r\n");
-            bufAddNull(op);
-            wp->flags &= ~WEBS_CHUNKING;
-        }
-    }
-    trace(6, "websFlush: buflen %d", bufLen(op));
     written = 0;
-    while ((nbytes = bufLen(op)) > 0) {
-        if ((written = websWriteSocket(wp, op->servp, nbytes)) < 0) {
+    do {
+        /*
+            The open chunk and the trailer follow a transferred block, so they are framed once the block is written
+         */
+        if ((wp->flags & WEBS_CHUNKING) && !wp->txBlock) {
+            trace(6, "websFlush chunking finalized %d", wp->finalized);
+            closeChunk(wp);
+            if (wp->finalized && (bufRoom(op) > 8 || bufGrow(op, 0))) {
+                trace(6, "websFlush: write chunk trailer");
+                bufPutStr(op, "\r\n0\r\n\r\n");
+                bufAddNull(op);
+                wp->flags &= ~WEBS_CHUNKING;
+            }
+        }
+        if ((nbytes = bufLen(op) + wp->txBlockLen) == 0) {
+            break;
+        }
+        trace(6, "websFlush: buflen %d", nbytes);
+        if ((written = writeOutput(wp, more)) < 0) {
             errCode = socketGetError(wp->sid);
             if (errCode == EWOULDBLOCK || errCode == EAGAIN) {
                 /* Not an error */
@@ -2084,21 +3211,23 @@ PUBLIC int websFlush(Webs *wp, bool block)
              */
             wp->flags &= ~WEBS_KEEP_ALIVE;
             bufFlush(op);
+            if (wp->txBlock) {
+                freeTxBlock(wp);
+            }
             wp->state = WEBS_COMPLETE;
             break;
-        } else if (written == 0) {
-            break;
         }
         trace(6, "websFlush: wrote %d to socket", written);
-        bufAdjustStart(op, written);
-        bufCompact(op);
-        nbytes = bufLen(op);
-    }
+    } while (written == nbytes);
+
     assert(websValid(wp));
 
-    if (bufLen(op) == 0 && wp->finalized) {
+    if (bufLen(op) == 0 && !wp->txBlock && wp->finalized) {
         wp->state = WEBS_COMPLETE;
     }
+    if (!more) {
+        socketPush(wp->sid);
+    }
     if (block) {
         socketSetBlock(wp->sid, wasBlocking);
     }
@@ -2106,7 +3235,7 @@ PUBLIC int websFlush(Webs *wp, bool block)
         /* I/O Error */
         return -1;
     }
-    return bufLen(op) == 0;
+    return bufLen(op) == 0 && !wp->txBlock;
 }
 
 
@@ -2118,16 +3247,21 @@ PUBLIC int websFlush(Webs *wp, bool block)
 static void writeEvent(Webs *wp)
 {
     WebsBuf     *op;
+    WebsSocket  *sp;
 
     op = &wp->output;
-    if (bufLen(op) > 0) {
-        websFlush(wp, 0);
+    if (bufLen(op) > 0 || wp->txBlock) {
+        flushOutput(wp, 0, !wp->finalized);
     }
-    if (bufLen(op) == 0 && wp->writeData) {
+    if (bufLen(op) == 0 && !wp->txBlock && wp->writeData) {
         (wp->writeData)(wp);
     }
     if (wp->state != WEBS_RUNNING) {
         websPump(wp);
+
+    } else if (bufLen(op) == 0 && !wp->txBlock && !wp->writeData && (sp = socketPtr(wp->sid)) != NULL) {
+        /* Output drained and the handler is not ready to write more. Stop listening for writable events. */
+        socketRegisterInterest(wp->sid, sp->handlerMask & ~SOCKET_WRITABLE);
     }
 }
 
@@ -2140,12 +3274,13 @@ PUBLIC void websSetBackgroundWriter(Webs *wp, WebsWriteProc proc)
     assert(proc);
 
     wp->writeData = proc;
+    wp->flags |= WEBS_NONBLOCK;
     op = &wp->output;
 
-    if (bufLen(op) > 0) {
-        websFlush(wp, 0);
+    if (bufLen(op) > 0 || wp->txBlock) {
+        flushOutput(wp, 0, !wp->finalized);
     }
-    if (bufLen(op) == 0) {
+    if (bufLen(op) == 0 && !wp->txBlock) {
         (wp->writeData)(wp);
     }
     if (wp->sid >= 0 && wp->state < WEBS_COMPLETE) {
@@ -2163,7 +3298,8 @@ PUBLIC void websSetBackgroundWriter(Webs *wp, WebsWriteProc proc)
 PUBLIC ssize websWriteBlock(Webs *wp, cchar *buf, ssize size)
 {
     WebsBuf     *op;
-    ssize       written, thisWrite, len, room;
+    WebsSocket  *sp;
+    ssize       written, thisWrite, room, need;
 
     assert(wp);
     assert(websValid(wp));
@@ -2173,20 +3309,37 @@ PUBLIC ssize websWriteBlock(Webs *wp, cchar *buf, ssize size)
     if (wp->state >= WEBS_COMPLETE) {
         return -1;
     }
-    op = (wp->flags & WEBS_CHUNKING) ? &wp->chunkbuf : &wp->output;
-    written = len = 0;
+    op = &wp->output;
+    written = 0;
 
     while (size > 0 && wp->state < WEBS_COMPLETE) {
-        if (bufRoom(op) < size) {
+        if (!wp->txBlock && (room = outputRoom(wp)) == 0 && growBuf(wp, op)) {
+            /* Buffer more of the response to write it in fewer, larger blocks */
+            room = outputRoom(wp);
+        }
+        if (wp->txBlock || room == 0) {
             /*
-                This will do a blocking I/O write. Will only ever fail for I/O errors.
+                Non-blocking write of buffered data. If the socket cannot accept more, grow the output buffer up to
+                the connection output limit. A transferred block that is not yet written is moved into the output
+                buffer first so this data is ordered after it. The block is already held in memory, so for handlers
+                that cannot resume writing, all of it is moved.
              */
-            if (websFlush(wp, 1) < 0) {
+            if (flushOutput(wp, 0, 1) < 0) {
                 return -1;
             }
-        }
-        if ((room = bufRoom(op)) == 0) {
-            break;
+            if (wp->txBlock) {
+                need = wp->txBlockLen + size + CHUNK_DIGITS + 4 - bufRoom(op);
+                if (!(wp->flags & WEBS_NONBLOCK) && need > 0) {
+                    bufGrow(op, need);
+                }
+                spillTxBlock(wp);
+            }
+            if (!wp->txBlock && (room = outputRoom(wp)) == 0 && bufGrow(op, 0)) {
+                room = outputRoom(wp);
+            }
+            if (wp->txBlock || room == 0) {
+                break;
+            }
         }
         thisWrite = min(room, size);
         bufPutBlk(op, buf, thisWrite);
@@ -2195,6 +3348,26 @@ PUBLIC ssize websWriteBlock(Webs *wp, cchar *buf, ssize size)
         written += thisWrite;
     }
     bufAddNull(op);
+    if (size > 0 && wp->state < WEBS_COMPLETE) {
+        if (wp->flags & WEBS_NONBLOCK) {
+            /*
+                Would block. Resume writing when the socket is writable.
+             */
+            if ((sp = socketPtr(wp->sid)) != NULL) {
+                socketRegisterInterest(wp->sid, sp->handlerMask | SOCKET_WRITABLE);
+            }
+        } else {
+            /*
+                The handler cannot resume writing and the client is not accepting the response. Abort the response
+                and close the connection rather than block the server.
+             */
+            error("Response for %s exceeds the output limit while the client is not reading. Closing connection.",
+                wp->url);
+            wp->flags &= ~WEBS_KEEP_ALIVE;
+            bufFlush(&wp->output);
+            wp->state = WEBS_COMPLETE;
+        }
+    }
     if (wp->state >= WEBS_COMPLETE && written == 0) {
         return -1;
     }
@@ -2202,6 +3375,65 @@ PUBLIC ssize websWriteBlock(Webs *wp, cchar *buf, ssize size)
 }
 
 
+PUBLIC ssize websTransferBlock(Webs *wp, char *buf, ssize size)
+{
+    WebsSocket  *sp;
+    WebsBuf     *op;
+    ssize       rc, len;
+    char        prefix[16];
+    bool        queue;
+
+    assert(wp);
+    assert(websValid(wp));
+    assert(buf);
+    assert(size >= 0);
+
+    if (wp->state >= WEBS_COMPLETE) {
+        wfree(buf);
+        return -1;
+    }
+    op = &wp->output;
+    if (wp->txBlock && flushOutput(wp, 0, 1) < 0) {
+        wfree(buf);
+        return -1;
+    }
+    /*
+        The block can only be queued if no other block is pending. The open chunk is closed so the block is framed
+        as a chunk of its own.
+     */
+    queue = size > 0 && !wp->txBlock;
+    len = 0;
+    if (queue && (wp->flags & WEBS_CHUNKING)) {
+        fmt(prefix, sizeof(prefix), "\r\n%x\r\n", size);
+        len = slen(prefix);
+        closeChunk(wp);
+        if (bufRoom(op) <= len && !bufGrow(op, 0)) {
+            queue = 0;
+        }
+    }
+    if (!queue) {
+        /* Buffer a copy instead */
+        rc = (size > 0) ? websWriteBlock(wp, buf, size) : 0;
+        wfree(buf);
+        return rc;
+    }
+    if (len > 0) {
+        bufPutBlk(op, prefix, len);
+        bufAddNull(op);
+    }
+    wp->txBlock = wp->txBlockNext = buf;
+    wp->txBlockLen = size;
+    if (flushOutput(wp, 0, !wp->finalized) < 0) {
+        return -1;
+    }
+    if (wp->txBlock && (sp = socketPtr(wp->sid)) != NULL) {
+        /* Resume writing the block when the socket is writable */
+        socketRegisterInterest(wp->sid, sp->handlerMask | SOCKET_WRITABLE);
+    }
+    return size;
+}
+
+
 /*
     Decode a URL (or part thereof). Allows insitu decoding.
  */
@@ -2258,33 +3490,11 @@ PUBLIC void websDecodeUrl(char *decoded, char *input, ssize len)
  */
 static void logRequest(Webs *wp, int code)
 {
-    char        *buf, timeStr[28], zoneStr[6], dataStr[16];
+    char        *buf, dataStr[16];
     ssize       len;
-    WebsTime    timer;
-    struct tm   localt;
-#if WINDOWS
-    DWORD       dwRet;
-    TIME_ZONE_INFORMATION tzi;
-#endif
 
     assert(wp);
-    time(&timer);
-#if WINDOWS
-    localtime_s(&localt, &timer);
-#else
-    localtime_r(&timer, &localt);
-#endif
-    strftime(timeStr, sizeof(timeStr), "%d/%b/%Y:%H:%M:%S", &localt);
-    timeStr[sizeof(timeStr) - 1] = '\0';
-#if WINDOWS
-    dwRet = GetTimeZoneInformation(&tzi);
-    fmt(zoneStr, sizeof(zoneStr), "%+03d00", -(int) (tzi.Bias/60));
-#elif !VXWORKS
-    fmt(zoneStr, sizeof(zoneStr), "%+03d00", (int) (localt.tm_gmtoff/3600));
-#else
-    zoneStr[0] = '\0';
-#endif
-    zoneStr[sizeof(zoneStr) - 1] = '\0';
+    updateDate();
     if (wp->written != 0) {
         fmt(dataStr, sizeof(dataStr), "%Ld", wp->written);
         dataStr[sizeof(dataStr) - 1] = '\0';
@@ -2292,9 +3502,9 @@ static void logRequest(Webs *wp, int code)
         dataStr[0] = '-'; dataStr[1] = '\0';
     }
     buf = NULL;
-    buf = sfmt("%s - %s [%s %s] \"%s %s %s\" %d %s\n",
+    buf = sfmt("%s - %s [%s] \"%s %s %s\" %d %s\n",
         wp->ipaddr, wp->username == NULL ? "-" : wp->username,
-        timeStr, zoneStr, wp->method, wp->path, wp->protoVersion, code, dataStr);
+        logTimeString, wp->method, wp->path, wp->protoVersion, code, dataStr);
     len = strlen(buf);
     write(accessFd, buf, len);
     wfree(buf);
@@ -2316,12 +3526,13 @@ static void checkTimeout(void *arg, int id)
     assert(websValid(wp));
 
     elapsed = getTimeSinceMark(wp) * 1000;
-    if (websDebug) {
+    if (websDebug || (wp->flags & WEBS_ASYNC)) {
+        /* Cannot free the request while an asynchronous action is using it */
         websRestartEvent(id, (int) WEBS_TIMEOUT);
         return;
     }
     if (elapsed >= WEBS_TIMEOUT) {
-        if (!(wp->flags & WEBS_HEADERS_CREATED)) {
+        if (!(wp->flags & WEBS_HEADERS_CREATED) && allocBufs(wp) == 0) {
             if (wp->state > WEBS_BEGIN) {
                 websError(wp, HTTP_CODE_REQUEST_TIMEOUT, "Request exceeded timeout");
             } else {
@@ -2432,8 +3643,7 @@ PUBLIC void websSetRequestFilename(Webs *wp, cchar *filename)
     assert(websValid(wp));
     assert(filename && *filename);
 
-    wfree(wp->filename);
-    wp->filename = sclone(filename);
+    wp->filename = arenaClone(&wp->arena, filename);
     websSetVar(wp, "PATH_TRANSLATED", wp->filename);
 }
 #endif
@@ -2443,16 +3653,13 @@ PUBLIC int websRewriteRequest(Webs *wp, cchar *url)
 {
     char    *buf, *path;
 
-    wfree(wp->url);
-    wp->url = sclone(url);
-    wfree(wp->path);
+    wp->url = arenaClone(&wp->arena, url);
     wp->path = 0;
 
     if (websUrlParse(url, &buf, NULL, NULL, NULL, &path, NULL, NULL, NULL) < 0) {
         return -1;
     }
-    wp->path = sclone(path);
-    wfree(wp->filename);
+    wp->path = arenaClone(&wp->arena, path);
     wp->filename = 0;
     wp->flags |= WEBS_REROUTE;
     wfree(buf);
@@ -2483,10 +3690,9 @@ PUBLIC char *websGetDateString(WebsFileInfo *sbuf)
     char        *cp;
 
     if (sbuf == NULL) {
-        time(&now);
-    } else {
-        now = sbuf->mtime;
+        return sclone(websGetDate());
     }
+    now = sbuf->mtime;
 #if ME_UNIX_LIKE
     gmtime_r(&now, &tm);
 #else
@@ -2504,6 +3710,70 @@ PUBLIC char *websGetDateString(WebsFileInfo *sbuf)
 }
 
 
+/*
+    Render the date strings for the current second. Responses and the access log within the same second share them.
+ */
+static void updateDate()
+{
+    WebsTime    now;
+    struct tm   tm;
+    char        *cp;
+#if ME_GOAHEAD_ACCESS_LOG
+    char        timeStr[28], zoneStr[6];
+#if WINDOWS
+    TIME_ZONE_INFORMATION tzi;
+#endif
+#endif
+
+    time(&now);
+    if (now == dateTime) {
+        return;
+    }
+    dateTime = now;
+#if ME_UNIX_LIKE
+    gmtime_r(&now, &tm);
+#else
+    {
+        struct tm *tp;
+        tp = gmtime(&now);
+        tm = *tp;
+    }
+#endif
+    if ((cp = asctime(&tm)) != NULL) {
+        scopy(dateString, sizeof(dateString), cp);
+        if ((cp = strchr(dateString, '\n')) != NULL) {
+            *cp = '\0';
+        }
+    }
+#if ME_GOAHEAD_ACCESS_LOG
+#if WINDOWS
+    localtime_s(&tm, &now);
+#else
+    localtime_r(&now, &tm);
+#endif
+    strftime(timeStr, sizeof(timeStr), "%d/%b/%Y:%H:%M:%S", &tm);
+    timeStr[sizeof(timeStr) - 1] = '\0';
+#if WINDOWS
+    GetTimeZoneInformation(&tzi);
+    fmt(zoneStr, sizeof(zoneStr), "%+03d00", -(int) (tzi.Bias/60));
+#elif !VXWORKS
+    fmt(zoneStr, sizeof(zoneStr), "%+03d00", (int) (tm.tm_gmtoff/3600));
+#else
+    zoneStr[0] = '\0';
+#endif
+    zoneStr[sizeof(zoneStr) - 1] = '\0';
+    fmt(logTimeString, sizeof(logTimeString), "%s %s", timeStr, zoneStr);
+#endif
+}
+
+
+PUBLIC cchar *websGetDate()
+{
+    updateDate();
+    return dateString;
+}
+
+
 /*
     Take not of the request activity and mark the time. Set a timestamp so that, later, we can return the number of seconds
     since we made the mark.
@@ -2924,13 +4194,10 @@ PUBLIC void websSetCookie(Webs *wp, cchar *name, cchar *value, cchar *path, ccha
      */
     secure = (flags & WEBS_COOKIE_SECURE) ? "; secure" : "";
     httponly = (flags & WEBS_COOKIE_HTTP) ?  "; httponly" : "";
-    cookie = sfmt("%s=%s; path=%s%s%s%s%s%s%s", name, value, path, domainAtt, domain, expiresAtt, expires, secure,
-        httponly);
+    cookie = arenaFmt(&wp->arena, "%s=%s; path=%s%s%s%s%s%s%s", name, value, path, domainAtt, domain, expiresAtt,
+        expires, secure, httponly);
     if (wp->responseCookie) {
-        old = wp->responseCookie;
-        wp->responseCookie = sfmt("%s %s", wp->responseCookie, cookie);
-        wfree(old);
-        wfree(cookie);
+        wp->responseCookie = arenaFmt(&wp->arena, "%s %s", wp->responseCookie, cookie);
     } else {
         wp->responseCookie = cookie;
     }
@@ -2984,6 +4251,133 @@ PUBLIC void websSetBackground(int on)
 }
 
 
+PUBLIC int websGetWorkers()
+{
+    return workerCount;
+}
+
+
+PUBLIC void websSetWorkers(int count)
+{
+    workerCount = max(count, 0);
+}
+
+
+#if ME_UNIX_LIKE
+/*
+    Fork the worker processes and supervise them. Workers that exit are restarted, but not more than once per second
+    so a worker that fails on startup does not spin.
+ */
+PUBLIC int websStartWorkers(int *finished)
+{
+    WebsTime    *started;
+    int         *pids, i, pid, status;
+
+    if (workerCount <= 0) {
+        return 0;
+    }
+    pids = walloc(workerCount * sizeof(int));
+    started = walloc(workerCount * sizeof(WebsTime));
+    if (pids == 0 || started == 0) {
+        wfree(pids);
+        wfree(started);
+        return -1;
+    }
+    memset(pids, 0, workerCount * sizeof(int));
+    memset(started, 0, workerCount * sizeof(WebsTime));
+
+    while (!*finished) {
+        for (i = 0; i < workerCount; i++) {
+            if (pids[i] > 0 || (started[i] && (time(0) - started[i]) < 1)) {
+                continue;
+            }
+            if ((pid = fork()) < 0) {
+                error("Cannot fork worker, errno %d", errno);
+                break;
+            } else if (pid == 0) {
+                wfree(pids);
+                wfree(started);
+                return initWorker();
+            }
+            pids[i] = pid;
+            started[i] = time(0);
+            logmsg(2, "Started worker %d, pid %d", i, pid);
+        }
+        if ((pid = waitpid(-1, &status, WNOHANG)) > 0) {
+            for (i = 0; i < workerCount; i++) {
+                if (pids[i] == pid) {
+                    error("Worker %d, pid %d exited with status %d, restarting", i, pid, status);
+                    pids[i] = 0;
+                    break;
+                }
+            }
+        } else {
+            usleep(100 * 1000);
+        }
+    }
+    for (i = 0; i < workerCount; i++) {
+        if (pids[i] > 0) {
+            kill(pids[i], SIGTERM);
+        }
+    }
+    for (i = 0; i < workerCount; i++) {
+        if (pids[i] > 0) {
+            waitpid(pids[i], &status, 0);
+        }
+    }
+    wfree(pids);
+    wfree(started);
+    return 1;
+}
+
+
+/*
+    Prepare a newly forked worker. The worker must not share the parent's event descriptor or SSL random state.
+    The master has no listening sockets, so each worker opens its own with SO_REUSEPORT.
+ */
+static int initWorker()
+{
+    WebsSocket  *sp;
+    char        *ip;
+    int         i, port, secure, sid;
+
+#if LINUX
+    /* Terminate if the master exits */
+    prctl(PR_SET_PDEATHSIG, SIGTERM);
+#endif
+    if (socketReopenEvents() < 0) {
+        error("Cannot reopen socket events in worker");
+    }
+#if ME_COM_SSL
+    sslClose();
+    if (sslOpen() < 0) {
+        return -1;
+    }
+#endif
+    for (i = 0; i < listenMax; i++) {
+        /* Open with the flags used by websListen so every worker, including restarted ones, has the same cork mode */
+        socketParseAddress(listenEndpoints[i], &ip, &port, &secure, 80);
+        sid = socketListen(ip, port, websAccept, listenFlags[i] | SOCKET_REUSEPORT);
+        wfree(ip);
+        if (sid < 0) {
+            error("Worker unable to open socket on port %d", port);
+            return -1;
+        }
+        sp = socketPtr(sid);
+        sp->secure = secure;
+        listens[i] = sid;
+    }
+    return 0;
+}
+#else
+
+PUBLIC int websStartWorkers(int *finished)
+{
+    return workerCount > 0 ? -1 : 0;
+}
+#endif /* ME_UNIX_LIKE */
+
+
 PUBLIC int websGetDebug()
 {
     return websDebug;
@@ -3346,8 +4740,8 @@ PUBLIC void websError(Webs *wp, int code, cchar *fmt, ...)
         wp->flags &= ~WEBS_KEEP_ALIVE;
     }
     encoded = websEscapeHtml(wp->url);
-    wfree(wp->url);
-    wp->url = encoded;
+    wp->url = arenaClone(&wp->arena, encoded);
+    wfree(encoded);
     if (fmt) {
         if (!(code & WEBS_NOLOG)) {
             va_start(args, fmt);
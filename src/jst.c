@@ -24,6 +24,7 @@ static WebsHash websJstFunctions = -1;  /* Symbol table of functions */
 
 /***************************** Forward Declarations ***************************/
 
+static void renderJst(Webs *wp);
 static char *strtokcmp(char *s1, char *s2);
 static char *skipWhite(char *s);
 
@@ -36,15 +37,17 @@ static char *skipWhite(char *s);
 static bool jstHandler(Webs *wp)
 {
     WebsFileInfo    sbuf;
-    char            *lang, *token, *result, *ep, *cp, *buf, *nextp, *last;
+    WebsJstState    *js;
+    char            *buf;
     ssize           len;
-    int             rc, jid;
+    int             jid;
 
     assert(websValid(wp));
     assert(wp->filename && *wp->filename);
     assert(wp->ext && *wp->ext);
 
     buf = 0;
+    websSetHeaderVars(wp);
     if ((jid = jsOpenEngine(wp->vars, websJstFunctions)) < 0) {
         websError(wp, HTTP_CODE_INTERNAL_SERVER_ERROR, "Cannot create JavaScript engine");
         goto done;
@@ -74,17 +77,70 @@ static bool jstHandler(Webs *wp)
         goto done;
     }
     websPageClose(wp);
+    if ((js = arenaAlloc(&wp->arena, sizeof(WebsJstState))) == NULL) {
+        websError(wp, HTTP_CODE_INTERNAL_SERVER_ERROR, "Cannot get memory");
+        goto done;
+    }
     websWriteHeaders(wp, (ssize) -1, 0);
     websWriteHeader(wp, "Pragma", "no-cache");
     websWriteHeader(wp, "Cache-Control", "no-cache");
     websWriteEndHeaders(wp);
 
-    /*
-        Scan for the next "<%"
-     */
-    last = buf;
-    for (rc = 0; rc == 0 && *last && ((nextp = strstr(last, "<%")) != NULL); ) {
-        websWriteBlock(wp, last, (nextp - last));
+    js->page = js->next = buf;
+    js->jid = jid;
+    wp->jstState = js;
+    wp->writeData = renderJst;
+    renderJst(wp);
+    return 1;
+
+/*
+    Common exit and cleanup
+ */
+done:
+    if (websValid(wp)) {
+        websPageClose(wp);
+        if (jid >= 0) {
+            jsCloseEngine(jid);
+        }
+    }
+    websDone(wp);
+    wfree(buf);
+    return 1;
+}
+
+
+/*
+    Render the page from where it was last suspended. Before each script, if the client has not accepted the prior
+    output, rendering is suspended and resumes when the socket is writable. A script runs to completion, so its
+    output is subject to the ME_GOAHEAD_LIMIT_OUTPUT limit of websWriteBlock.
+ */
+static void renderJst(Webs *wp)
+{
+    WebsJstState    *js;
+    WebsSocket      *sp;
+    char            *lang, *token, *result, *ep, *cp, *nextp;
+
+    js = wp->jstState;
+    assert(js);
+
+    while (*js->next && wp->state < WEBS_COMPLETE) {
+        if (bufLen(&wp->output) >= ME_GOAHEAD_LIMIT_BUFFER && websFlush(wp, 0) == 0) {
+            if ((sp = socketPtr(wp->sid)) != NULL) {
+                socketRegisterInterest(wp->sid, sp->handlerMask | SOCKET_WRITABLE);
+            }
+            return;
+        }
+        /*
+            Scan for the next "<%"
+         */
+        if ((nextp = strstr(js->next, "<%")) == NULL) {
+            /*
+                Output any trailing HTML page text
+             */
+            websWriteBlock(wp, js->next, strlen(js->next));
+            break;
+        }
+        websWriteBlock(wp, js->next, (nextp - js->next));
         nextp = skipWhite(nextp + 2);
         /*
             Decode the language
@@ -102,73 +158,69 @@ static bool jstHandler(Webs *wp)
         /*
             Find tailing bracket and then evaluate the script
          */
-        if ((ep = strstr(nextp, "%>")) != NULL) {
-
-            *ep = '\0';
-            last = ep + 2;
-            nextp = skipWhite(nextp);
-            /*
-                Handle backquoted newlines
-             */
-            for (cp = nextp; *cp; ) {
-                if (*cp == '\\' && (cp[1] == '\r' || cp[1] == '\n')) {
+        if ((ep = strstr(nextp, "%>")) == NULL) {
+            websError(wp, HTTP_CODE_INTERNAL_SERVER_ERROR, "Unterminated script in %s: \n", wp->filename);
+            break;
+        }
+        *ep = '\0';
+        js->next = ep + 2;
+        nextp = skipWhite(nextp);
+        /*
+            Handle backquoted newlines
+         */
+        for (cp = nextp; *cp; ) {
+            if (*cp == '\\' && (cp[1] == '\r' || cp[1] == '\n')) {
+                *cp++ = ' ';
+                while (*cp == '\r' || *cp == '\n') {
                     *cp++ = ' ';
-                    while (*cp == '\r' || *cp == '\n') {
-                        *cp++ = ' ';
-                    }
-                } else {
-                    cp++;
                 }
+            } else {
+                cp++;
             }
-            if (*nextp) {
-                result = NULL;
-
-                if (jsEval(jid, nextp, &result) == 0) {
-                    /*
-                         On an error, discard all output accumulated so far and store the error in the result buffer.
-                         Be careful if the user has called websError() already.
-                     */
-                    rc = -1;
-                    if (websValid(wp)) {
-                        if (result) {
-                            websWrite(wp, "<h2><b>Javascript Error: %s</b></h2>\n", result);
-                            websWrite(wp, "<pre>%s</pre>", nextp);
-                            wfree(result);
-                        } else {
-                            websWrite(wp, "<h2><b>Javascript Error</b></h2>\n%s\n", nextp);
-                        }
-                        websWrite(wp, "</body></html>\n");
-                        rc = 0;
+        }
+        if (*nextp) {
+            result = NULL;
+
+            if (jsEval(js->jid, nextp, &result) == 0) {
+                /*
+                     On an error, discard all output accumulated so far and store the error in the result buffer.
+                     Be careful if the user has called websError() already.
+                 */
+                if (websValid(wp)) {
+                    if (result) {
+                        websWrite(wp, "<h2><b>Javascript Error: %s</b></h2>\n", result);
+                        websWrite(wp, "<pre>%s</pre>", nextp);
+                        wfree(result);
+                    } else {
+                        websWrite(wp, "<h2><b>Javascript Error</b></h2>\n%s\n", nextp);
                     }
-                    goto done;
+                    websWrite(wp, "</body></html>\n");
                 }
+                break;
             }
-
-        } else {
-            websError(wp, HTTP_CODE_INTERNAL_SERVER_ERROR, "Unterminated script in %s: \n", wp->filename);
-            goto done;
         }
     }
-    /*
-        Output any trailing HTML page text
-     */
-    if (last && *last && rc == 0) {
-        websWriteBlock(wp, last, strlen(last));
-    }
+    websFreeJst(wp);
+    websDone(wp);
+}
+
 
 /*
-    Common exit and cleanup
+    Free the page and JavaScript engine of a page that is being rendered. The state itself is in the request arena.
  */
-done:
-    if (websValid(wp)) {
-        websPageClose(wp);
-        if (jid >= 0) {
-            jsCloseEngine(jid);
-        }
+PUBLIC void websFreeJst(Webs *wp)
+{
+    WebsJstState    *js;
+
+    if ((js = wp->jstState) == NULL) {
+        return;
     }
-    websDone(wp);
-    wfree(buf);
-    return 1;
+    wp->jstState = 0;
+    if (wp->writeData == renderJst) {
+        wp->writeData = 0;
+    }
+    jsCloseEngine(js->jid);
+    wfree(js->page);
 }
 
 
@@ -229,7 +281,15 @@ PUBLIC int websJstWrite(int jid, Webs *wp, int argc, char **argv)
 
 /* -------------------添加自己的jst------------------- */
 volatile unsigned int * map_base;
+static int regFd = -1;
+static int regLockDepth = 0;
+#if ME_UNIX_LIKE
+static pthread_mutex_t regLock = PTHREAD_RECURSIVE_MUTEX_INITIALIZER_NP;
+#endif
 
+/*
+    The register mapping is created before worker processes are forked and is shared by all workers
+ */
 void read_reg(void)
 {
     int fd;
@@ -237,10 +297,48 @@ void read_reg(void)
     if(fd<0) {
        printf("file open fail\n");
     }
+    regFd = fd;
     map_base = (unsigned int*)mmap(NULL, 0xff, PROT_READ|PROT_WRITE, MAP_SHARED, fd, ADC);
     //printf("map_base is %p \n", map_base);
 }
 
+
+/*
+    Lock the registers against access from other worker processes and asynchronous action threads. Threads are
+    excluded by a recursive mutex. Processes are excluded by a POSIX record lock which is owned by the process, so it
+    excludes other workers even though they share the inherited descriptor. Locks may be nested.
+ */
+PUBLIC void websLockRegisters()
+{
+#if ME_UNIX_LIKE
+    struct flock    lock;
+
+    pthread_mutex_lock(&regLock);
+    if (regFd >= 0 && websGetWorkers() > 0 && regLockDepth++ == 0) {
+        memset(&lock, 0, sizeof(lock));
+        lock.l_type = F_WRLCK;
+        lock.l_whence = SEEK_SET;
+        while (fcntl(regFd, F_SETLKW, &lock) < 0 && errno == EINTR) {}
+    }
+#endif
+}
+
+
+PUBLIC void websUnlockRegisters()
+{
+#if ME_UNIX_LIKE
+    struct flock    lock;
+
+    if (regFd >= 0 && websGetWorkers() > 0 && regLockDepth > 0 && --regLockDepth == 0) {
+        memset(&lock, 0, sizeof(lock));
+        lock.l_type = F_UNLCK;
+        lock.l_whence = SEEK_SET;
+        fcntl(regFd, F_SETLK, &lock);
+    }
+    pthread_mutex_unlock(&regLock);
+#endif
+}
+
 unsigned int REG_READ_4byte(int offset)
 {
 	return *(map_base + offset);
@@ -259,6 +357,7 @@ void PL_REG_WRITE(unsigned int addr, unsigned int value)
 
 void  FPGA_write(unsigned int addr, unsigned int data)  //write data to all fpga
 {      
+        websLockRegisters();
         PL_REG_WRITE(ADDR_FPGA_rw_addr,addr);  //write the fpga addr to point in the pl
         PL_REG_WRITE(ADDR_FPGA_wr_data,data);  //write the data to bus in the pl
 	 
@@ -269,6 +368,7 @@ void  FPGA_write(unsigned int addr, unsigned int data)  //write data to all fpga
         PL_REG_WRITE(ADDR_FPGA_rw_ctrl,0x00);  //write bit0:begin read or write
 
         PL_REG_WRITE(ADDR_FPGA_rw_ctrl,0x00);  //normal
+        websUnlockRegisters();
 }
 
 
@@ -276,6 +376,7 @@ unsigned char FPGA_read(unsigned int fpga_id, unsigned int addr)  //write data t
 {      
      unsigned char data_read_from_fpga;
 
+        websLockRegisters();
         PL_REG_WRITE(ADDR_FPGA_rw_addr,addr);  //write the fpga addr to point in the pl
         
 
@@ -302,6 +403,7 @@ unsigned char FPGA_read(unsigned int fpga_id, unsigned int addr)  //write data t
         
         data_read_from_fpga = PL_REG_READ(ADDR_FPGA_rd_data);   //low 8 bit 
         PL_REG_WRITE(ADDR_FPGA_rw_ctrl,0x00);  //normal
+        websUnlockRegisters();
 	return data_read_from_fpga;
 }
 
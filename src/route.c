@@ -155,8 +155,7 @@ PUBLIC bool websRunRequest(Webs *wp)
         return 1;
     }
     if (!wp->filename || route->dir) {
-        wfree(wp->filename);
-        wp->filename = sfmt("%s%s", route->dir ? route->dir : websGetDocuments(), wp->path);
+        wp->filename = arenaFmt(&wp->arena, "%s%s", route->dir ? route->dir : websGetDocuments(), wp->path);
     }
     if (!(wp->flags & WEBS_VARS_ADDED)) {
         if (wp->query && *wp->query) {
@@ -10,13 +10,32 @@
 
 /*********************************** Defines **********************************/
 /*
-    This structure stores scheduled events.
+    Scheduled events are kept in a hierarchical timer wheel with millisecond resolution. Each level has
+    WHEEL_SLOTS slots and each slot at a level spans WHEEL_SLOTS times the period of the level below.
+    Level zero slots are one millisecond wide. Events are placed in the level and slot for their due time and are
+    cascaded to lower levels as the wheel turns. Start, restart and stop are O(1).
+ */
+#define WHEEL_BITS      6
+#define WHEEL_SLOTS     (1 << WHEEL_BITS)
+#define WHEEL_MASK      (WHEEL_SLOTS - 1)
+#define WHEEL_LEVELS    4
+#define WHEEL_SPAN      (((int64) 1) << (WHEEL_BITS * WHEEL_LEVELS))
+
+typedef struct EventLink {
+    struct EventLink *next;
+    struct EventLink *prev;
+} EventLink;
+
+/*
+    This structure stores scheduled events. The link must be first.
  */
 typedef struct Callback {
+    EventLink   link;                   /* Wheel slot list linkage */
     void        (*routine)(void *arg, int id);
     void        *arg;
-    WebsTime    at;
+    int64       at;                     /* Due time in ticks (msec) */
     int         id;
+    int         scheduled;              /* Event is linked into the wheel */
 } Callback;
 
 /*********************************** Defines **********************************/
@@ -151,6 +170,21 @@ typedef struct Format {
 
 #define RINGQ_LEN(bp) ((bp->servp > bp->endp) ? (bp->buflen + (bp->endp - bp->servp)) : (bp->endp - bp->servp))
 
+/*
+    Arena allocations are aligned to this boundary. The primary arena block is enlarged on reset to hold the
+    prior peak usage, up to ARENA_MAX.
+ */
+#define ARENA_ALIGN     8
+#define ARENA_MAX       (16 * 1024)
+
+/*
+    Overflow arena blocks are chained and freed on reset. The data follows the header.
+ */
+typedef struct ArenaBlock {
+    struct ArenaBlock *next;
+    int64       pad;                    /* Keep data aligned */
+} ArenaBlock;
+
 typedef struct HashTable {              /* Symbol table descriptor */
     WebsKey     **hash_table;           /* Allocated at run time */
     int         inuse;                  /* Is this entry in use */
@@ -171,6 +205,10 @@ PUBLIC int       logLevel;          /* Log verbosity level */
 static Callback  **callbacks;
 static int       callbackMax;
 
+static EventLink wheel[WHEEL_LEVELS][WHEEL_SLOTS];  /* Timer wheel slot lists */
+static int64     wheelTime;         /* Next tick to be processed by the wheel */
+static int       wheelCount;        /* Number of events in the wheel */
+
 static HashTable **sym;             /* List of symbol tables */
 static int       symMax;            /* One past the max symbol table */
 
@@ -183,7 +221,10 @@ static int       logFd;             /* Log file handle */
 
 /********************************** Forwards **********************************/
 
+static void cascadeEvents(int level);
 static int calcPrime(int size);
+static void linkEvent(Callback *cp);
+static void unlinkEvent(Callback *cp);
 static int getBinBlockSize(int size);
 static int hashIndex(HashTable *tp, cchar *name);
 static WebsKey *hash(HashTable *tp, cchar *name);
@@ -206,9 +247,18 @@ static void outFloat(Format *fmt, char specChar, double value);
 
 PUBLIC int websRuntimeOpen()
 {
+    int     level, slot;
+
     symMax = 0;
     sym = 0;
     srand((uint) time(NULL));
+    for (level = 0; level < WHEEL_LEVELS; level++) {
+        for (slot = 0; slot < WHEEL_SLOTS; slot++) {
+            wheel[level][slot].next = wheel[level][slot].prev = &wheel[level][slot];
+        }
+    }
+    wheelTime = websGetTicks();
+    wheelCount = 0;
     return 0;
 }
 
@@ -219,22 +269,127 @@ PUBLIC void websRuntimeClose()
 
 
 /*
-    This function is called when a scheduled process time has come.
+    Return a monotonic time in milliseconds. Used to schedule events and measure intervals.
+ */
+PUBLIC int64 websGetTicks()
+{
+#if ME_WIN_LIKE
+    return (int64) GetTickCount();
+#elif ME_UNIX_LIKE && defined(CLOCK_MONOTONIC)
+    struct timespec     ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((int64) ts.tv_sec) * 1000 + (ts.tv_nsec / 1000000);
+#elif ME_UNIX_LIKE
+    struct timeval      tv;
+
+    gettimeofday(&tv, NULL);
+    return ((int64) tv.tv_sec) * 1000 + (tv.tv_usec / 1000);
+#else
+    return ((int64) time(0)) * 1000;
+#endif
+}
+
+
+/*
+    Return a monotonic time in microseconds. Used to measure short intervals.
+ */
+PUBLIC int64 websGetHiResTicks()
+{
+#if ME_UNIX_LIKE && defined(CLOCK_MONOTONIC)
+    struct timespec     ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((int64) ts.tv_sec) * 1000000 + (ts.tv_nsec / 1000);
+#elif ME_UNIX_LIKE
+    struct timeval      tv;
+
+    gettimeofday(&tv, NULL);
+    return ((int64) tv.tv_sec) * 1000000 + tv.tv_usec;
+#else
+    return websGetTicks() * 1000;
+#endif
+}
+
+
+/*
+    Link an event into the wheel slot for its due time
+ */
+static void linkEvent(Callback *cp)
+{
+    EventLink   *head;
+    int64       due, delta;
+    int         level;
+
+    due = cp->at;
+    delta = due - wheelTime;
+    if (delta < 0) {
+        /* Already due. Run on the next tick processed */
+        due = wheelTime;
+        delta = 0;
+    } else if (delta >= WHEEL_SPAN) {
+        /* Beyond the range of the wheel. Park in the furthest slot and it will be re-linked when cascaded */
+        due = wheelTime + WHEEL_SPAN - 1;
+        delta = WHEEL_SPAN - 1;
+    }
+    for (level = 0; level < WHEEL_LEVELS - 1; level++) {
+        if (delta < (((int64) 1) << (WHEEL_BITS * (level + 1)))) {
+            break;
+        }
+    }
+    head = &wheel[level][(due >> (WHEEL_BITS * level)) & WHEEL_MASK];
+    cp->link.next = head;
+    cp->link.prev = head->prev;
+    head->prev->next = &cp->link;
+    head->prev = &cp->link;
+    cp->scheduled = 1;
+    wheelCount++;
+}
+
+
+static void unlinkEvent(Callback *cp)
+{
+    if (cp->scheduled) {
+        cp->link.prev->next = cp->link.next;
+        cp->link.next->prev = cp->link.prev;
+        cp->link.next = cp->link.prev = 0;
+        cp->scheduled = 0;
+        wheelCount--;
+    }
+}
+
+
+/*
+    Move the events in the current slot of a level down to lower levels
  */
-static void callEvent(int id)
+static void cascadeEvents(int level)
 {
+    EventLink   *head, list;
     Callback    *cp;
 
-    assert(0 <= id && id < callbackMax);
-    cp = callbacks[id];
-    assert(cp);
+    head = &wheel[level][(wheelTime >> (WHEEL_BITS * level)) & WHEEL_MASK];
+    if (head->next == head) {
+        return;
+    }
+    /*
+        Detach the slot list before re-linking as events may be re-linked into the same slot
+     */
+    list.next = head->next;
+    list.prev = head->prev;
+    list.next->prev = &list;
+    list.prev->next = &list;
+    head->next = head->prev = head;
 
-    (cp->routine)(cp->arg, cp->id);
+    while (list.next != &list) {
+        cp = (Callback*) list.next;
+        unlinkEvent(cp);
+        linkEvent(cp);
+    }
 }
 
 
 /*
-    Schedule an event in delay milliseconds time. We will use 1 second granularity for webServer.
+    Schedule an event in delay milliseconds time
  */
 PUBLIC int websStartEvent(int delay, WebsEventProc proc, void *arg)
 {
@@ -248,11 +403,8 @@ PUBLIC int websStartEvent(int delay, WebsEventProc proc, void *arg)
     s->routine = proc;
     s->arg = arg;
     s->id = id;
-
-    /*
-        Round the delay up to seconds.
-     */
-    s->at = ((delay + 500) / 1000) + time(0);
+    s->at = websGetTicks() + max(delay, 0);
+    linkEvent(s);
     return id;
 }
 
@@ -264,7 +416,9 @@ PUBLIC void websRestartEvent(int id, int delay)
     if (callbacks == NULL || id == -1 || id >= callbackMax || (s = callbacks[id]) == NULL) {
         return;
     }
-    s->at = ((delay + 500) / 1000) + time(0);
+    unlinkEvent(s);
+    s->at = websGetTicks() + max(delay, 0);
+    linkEvent(s);
 }
 
 
@@ -275,34 +429,77 @@ PUBLIC void websStopEvent(int id)
     if (callbacks == NULL || id == -1 || id >= callbackMax || (s = callbacks[id]) == NULL) {
         return;
     }
+    unlinkEvent(s);
     wfree(s);
     callbackMax = wfreeHandle(&callbacks, id);
 }
 
 
+/*
+    Run due events and return the delay in milliseconds till the next event is due. An event runs once unless the
+    callback restarts it via websRestartEvent. The callback may also stop the event or schedule other events.
+ */
 int websRunEvents()
 {
-    Callback    *s;
-    WebsTime    now;
-    int         i, delay, nextEvent;
-
-    nextEvent = (MAXINT / 1000);
-    now = time(0);
-
-    for (i = 0; i < callbackMax; i++) {
-        if ((s = callbacks[i]) != NULL) {
-            if (s->at <= now) {
-                callEvent(i);
-                delay = MAXINT / 1000;
-                /* Rescan incase event scheduled or modified an event */
-                i = -1;
-            } else {
-                delay = (int) min(s->at - now, MAXINT / 1000);
+    EventLink   *head, list;
+    Callback    *cp;
+    int64       now, due, start;
+    int         level, slot, index, first;
+
+    now = websGetTicks();
+    if (wheelCount == 0) {
+        wheelTime = now + 1;
+        return MAXINT;
+    }
+    while (wheelTime <= now) {
+        /*
+            Cascade higher levels when the lower level wraps
+         */
+        for (level = 1; level < WHEEL_LEVELS; level++) {
+            if (((wheelTime >> (WHEEL_BITS * (level - 1))) & WHEEL_MASK) != 0) {
+                break;
             }
-            nextEvent = min(delay, nextEvent);
+            cascadeEvents(level);
+        }
+        head = &wheel[0][wheelTime & WHEEL_MASK];
+        wheelTime++;
+        if (head->next == head) {
+            continue;
+        }
+        list.next = head->next;
+        list.prev = head->prev;
+        list.next->prev = &list;
+        list.prev->next = &list;
+        head->next = head->prev = head;
+
+        while (list.next != &list) {
+            cp = (Callback*) list.next;
+            unlinkEvent(cp);
+            (cp->routine)(cp->arg, cp->id);
         }
     }
-    return nextEvent * 1000;
+    if (wheelCount == 0) {
+        return MAXINT;
+    }
+    /*
+        Find the earliest non-empty slot in each level. Level zero slots are exact. Higher level slots give the time
+        the slot will be cascaded which is never later than the events it holds. The current slot of a higher level
+        is still pending if the wheel is at the start of the slot period.
+     */
+    due = MAXINT64;
+    for (level = 0; level < WHEEL_LEVELS; level++) {
+        index = (int) ((wheelTime >> (WHEEL_BITS * level)) & WHEEL_MASK);
+        first = (wheelTime & ((((int64) 1) << (WHEEL_BITS * level)) - 1)) == 0 ? 0 : 1;
+        for (slot = first; slot <= WHEEL_SLOTS; slot++) {
+            head = &wheel[level][(index + slot) & WHEEL_MASK];
+            if (head->next != head) {
+                start = ((wheelTime >> (WHEEL_BITS * level)) + slot) << (WHEEL_BITS * level);
+                due = min(due, start);
+                break;
+            }
+        }
+    }
+    return (int) max(min(due - now, MAXINT), 0);
 }
 
 
@@ -344,6 +541,21 @@ PUBLIC char *fmt(char *buf, ssize bufsize, cchar *format, ...)
 }
 
 
+/*
+    Replacement for vsprintf
+ */
+PUBLIC char *fmtv(char *buf, ssize bufsize, cchar *format, va_list args)
+{
+    assert(buf);
+    assert(format);
+
+    if (bufsize <= 0) {
+        return 0;
+    }
+    return sprintfCore(buf, bufsize, format, args);
+}
+
+
 /*
     Scure vsprintf replacement
  */
@@ -1374,11 +1586,11 @@ PUBLIC int bufCreate(WebsBuf *bp, int initSize, int maxsize)
 PUBLIC void bufFree(WebsBuf *bp)
 {
     assert(bp);
-    assert(bp->buflen == (bp->endbuf - bp->buf));
 
-    if (bp == NULL) {
+    if (bp == NULL || bp->buf == NULL) {
         return;
     }
+    assert(bp->buflen == (bp->endbuf - bp->buf));
     bufFlush(bp);
     wfree((char*) bp->buf);
     bp->buf = NULL;
@@ -1863,6 +2075,168 @@ PUBLIC bool bufGrow(WebsBuf *bp, ssize room)
 }
 
 
+/*
+    Create an arena for short lived allocations that are all released together by arenaReset.
+ */
+PUBLIC int arenaCreate(WebsArena *ap, ssize size)
+{
+    assert(ap);
+
+    if (size <= 0) {
+        size = ME_GOAHEAD_LIMIT_BUFFER;
+    }
+    memset(ap, 0, sizeof(WebsArena));
+    if ((ap->buf = walloc(size)) == NULL) {
+        return -1;
+    }
+    ap->size = size;
+    ap->next = ap->buf;
+    ap->end = &ap->buf[size];
+    return 0;
+}
+
+
+static void freeArenaBlocks(WebsArena *ap)
+{
+    ArenaBlock  *bp, *next;
+
+    for (bp = ap->blocks; bp; bp = next) {
+        next = bp->next;
+        wfree(bp);
+    }
+    ap->blocks = 0;
+}
+
+
+PUBLIC void arenaFree(WebsArena *ap)
+{
+    assert(ap);
+
+    freeArenaBlocks(ap);
+    wfree(ap->buf);
+    ap->buf = ap->next = ap->end = NULL;
+    ap->size = ap->used = 0;
+}
+
+
+/*
+    Release all arena allocations in one operation. If the arena overflowed its primary block, the primary block is
+    enlarged so that a similar load will not overflow again.
+ */
+PUBLIC void arenaReset(WebsArena *ap)
+{
+    char    *buf;
+    ssize   size;
+
+    assert(ap);
+
+    if (ap->blocks) {
+        freeArenaBlocks(ap);
+        if (ap->used > ap->size && ap->size < ARENA_MAX) {
+            size = min(getBinBlockSize((int) ap->used), ARENA_MAX);
+            if ((buf = walloc(size)) != NULL) {
+                wfree(ap->buf);
+                ap->buf = buf;
+                ap->size = size;
+            }
+        }
+    }
+    ap->next = ap->buf;
+    ap->end = &ap->buf[ap->size];
+    ap->used = 0;
+}
+
+
+PUBLIC void *arenaAlloc(WebsArena *ap, ssize size)
+{
+    ArenaBlock  *bp;
+    ssize       blockSize;
+    char        *ptr;
+
+    assert(ap);
+    assert(size >= 0);
+
+    size = (size + ARENA_ALIGN - 1) & ~(ARENA_ALIGN - 1);
+    if (ap->next == NULL || size > (ap->end - ap->next)) {
+        blockSize = max(size, ap->size);
+        if ((bp = walloc(sizeof(ArenaBlock) + blockSize)) == NULL) {
+            return NULL;
+        }
+        bp->next = ap->blocks;
+        ap->blocks = bp;
+        ap->next = (char*) &bp[1];
+        ap->end = &ap->next[blockSize];
+    }
+    ptr = ap->next;
+    ap->next += size;
+    ap->used += size;
+    return ptr;
+}
+
+
+/*
+    Clone a string into the arena. A null string is cloned as an empty string.
+ */
+PUBLIC char *arenaClone(WebsArena *ap, cchar *str)
+{
+    char    *ptr;
+    ssize   len;
+
+    if (str == NULL) {
+        str = "";
+    }
+    len = slen(str);
+    if ((ptr = arenaAlloc(ap, len + 1)) != NULL) {
+        memcpy(ptr, str, len + 1);
+    }
+    return ptr;
+}
+
+
+PUBLIC char *arenaFmt(WebsArena *ap, cchar *format, ...)
+{
+    va_list     args;
+    char        *result;
+
+    assert(format);
+
+    va_start(args, format);
+    result = arenaFmtv(ap, format, args);
+    va_end(args);
+    return result;
+}
+
+
+/*
+    Format into the free space of the current arena block. If the result does not fit, format into a temporary
+    allocation and clone that into the arena.
+ */
+PUBLIC char *arenaFmtv(WebsArena *ap, cchar *format, va_list args)
+{
+    va_list     copy;
+    char        *result, *str;
+    ssize       room, len;
+
+    assert(ap);
+    assert(format);
+
+    room = ap->next ? (ap->end - ap->next) : 0;
+    if (room > 1) {
+        va_copy(copy, args);
+        sprintfCore(ap->next, room, format, copy);
+        va_end(copy);
+        len = slen(ap->next);
+        if (len < room - 1) {
+            return arenaAlloc(ap, len + 1);
+        }
+    }
+    str = sprintfCore(NULL, -1, format, args);
+    result = arenaClone(ap, str);
+    wfree(str);
+    return result;
+}
+
+
 /*
     Find the smallest binary memory size that "size" will fit into.  This makes the buf and bufGrow routines much
     more efficient. The walloc routine likes powers of 2 minus 1.
@@ -1960,6 +2334,34 @@ PUBLIC void hashFree(WebsHash sd)
 }
 
 
+/*
+    Remove all symbols from a hash table. The table and index are retained for reuse.
+ */
+PUBLIC void hashClear(WebsHash sd)
+{
+    HashTable   *tp;
+    WebsKey     *sp, *forw;
+    int         i;
+
+    if (sd < 0) {
+        return;
+    }
+    assert(0 <= sd && sd < symMax);
+    tp = sym[sd];
+    assert(tp);
+
+    for (i = 0; i < tp->size; i++) {
+        for (sp = tp->hash_table[i]; sp; sp = forw) {
+            forw = sp->forw;
+            valueFree(&sp->name);
+            valueFree(&sp->content);
+            wfree((void*) sp);
+        }
+        tp->hash_table[i] = NULL;
+    }
+}
+
+
 /*
     Return the first symbol in the hashtable if there is one. This call is used as the first step in traversing the
     table. A call to hashFirst should be followed by calls to hashNext to get all the rest of the entries.
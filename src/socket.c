@@ -17,11 +17,43 @@ PUBLIC int          socketOpenCount = 0;    /* Number of task using sockets */
 
 static int          hasIPv6;                /* System supports IPv6 */
 
+#if ME_GOAHEAD_STATS
+static int64        handlerCount;           /* Number of handler callbacks */
+static int64        handlerTime;            /* Total time in handler callbacks (usec) */
+static int64        handlerMax;             /* Longest handler callback (usec) */
+#endif
+
+#if ME_GOAHEAD_EPOLL && LINUX
+/*
+    Epoll state. Interest is registered with the kernel only when a socket handlerMask changes. Each call to
+    socketSelect records the sockets with events in readyList so socketProcess need not scan every socket.
+    Sockets flagged for re-servicing are kept in reserviceList as epoll does not know about them.
+ */
+#define SOCKET_MAX_EVENTS   64                  /* Maximum events to retrieve per epoll_wait */
+
+static int          epollFd = -1;           /* Epoll descriptor */
+static int          *readyList;             /* Socket IDs with events from the last socketSelect */
+static int          readyCount;             /* Number of entries in readyList */
+static int          readySize;              /* Allocated size of readyList */
+static int          *reserviceList;         /* Socket IDs needing re-servicing */
+static int          reserviceCount;         /* Number of entries in reserviceList */
+static int          reserviceSize;          /* Allocated size of reserviceList */
+
+#endif
+
 /***************************** Forward Declarations ***************************/
 
 static int ipv6(cchar *ip);
 static void socketAccept(WebsSocket *sp);
 static void socketDoEvent(WebsSocket *sp);
+#if !ME_WIN_LIKE
+static int selectSockets(int sid, int timeout);
+#endif
+#if ME_GOAHEAD_EPOLL && LINUX
+static int addSid(int **list, int *count, int *size, int sid);
+static int epollSockets(int timeout);
+static void epollUpdate(WebsSocket *sp);
+#endif
 
 /*********************************** Code *************************************/
 
@@ -54,6 +86,12 @@ PUBLIC int socketOpen()
     } else {
         trace(1, "This system does not have IPv6 support");
     }
+#if ME_GOAHEAD_EPOLL && LINUX
+    if ((epollFd = epoll_create1(EPOLL_CLOEXEC)) < 0) {
+        error("Cannot create epoll descriptor, errno %d. Using select instead.", errno);
+    }
+    readyCount = reserviceCount = 0;
+#endif
     return 0;
 }
 
@@ -69,6 +107,16 @@ PUBLIC void socketClose()
             }
         }
         socketOpenCount = 0;
+#if ME_GOAHEAD_EPOLL && LINUX
+        if (epollFd >= 0) {
+            close(epollFd);
+            epollFd = -1;
+        }
+        wfree(readyList);
+        wfree(reserviceList);
+        readyList = reserviceList = 0;
+        readyCount = readySize = reserviceCount = reserviceSize = 0;
+#endif
     }
 }
 
@@ -98,6 +146,7 @@ PUBLIC int socketListen(cchar *ip, int port, SocketAccept accept, int flags)
     struct sockaddr_storage addr;
     Socklen                 addrlen;
     cchar                   *sip;
+    char                    ifbuf[ME_MAX_IP];
     int                     family, protocol, sid, enable;
 
     if (port > SOCKET_PORT_MAX) {
@@ -135,12 +184,14 @@ PUBLIC int socketListen(cchar *ip, int port, SocketAccept accept, int flags)
     if (setsockopt(sp->sock, SOL_SOCKET, SO_REUSEADDR, (char*) &enable, sizeof(enable)) != 0) {
         error("Cannot set reuseaddr, errno %d", errno);
     }
-#if defined(SO_REUSEPORT) && KEEP
+#if defined(SO_REUSEPORT)
     /*
         This permits multiple servers listening on the same endpoint
      */
-    if (setsockopt(sp->sock, SOL_SOCKET, SO_REUSEPORT, (char*) &enable, sizeof(enable)) != 0) {
-        error("Cannot set reuseport, errno %d", errno);
+    if (flags & SOCKET_REUSEPORT) {
+        if (setsockopt(sp->sock, SOL_SOCKET, SO_REUSEPORT, (char*) &enable, sizeof(enable)) != 0) {
+            error("Cannot set reuseport, errno %d", errno);
+        }
     }
 #endif
 #elif ME_WIN_LIKE && defined(SO_EXCLUSIVEADDRUSE)
@@ -169,12 +220,26 @@ PUBLIC int socketListen(cchar *ip, int port, SocketAccept accept, int flags)
         socketFree(sid);
         return -1;
     }
+    if (flags & SOCKET_NOLISTEN) {
+        socketFree(sid);
+        return 0;
+    }
     if (listen(sp->sock, SOMAXCONN) < 0) {
         socketFree(sid);
         return -1;
     }
+    /*
+        If bound to a specific address, the local interface address is the same for all accepted connections
+     */
+    addrlen = sizeof(addr);
+    if (getsockname(sp->sock, (struct sockaddr*) &addr, &addrlen) == 0 &&
+            socketAddress((struct sockaddr*) &addr, (int) addrlen, ifbuf, sizeof(ifbuf), NULL) == 0) {
+        if (!smatch(ifbuf, "0.0.0.0") && !smatch(ifbuf, "::")) {
+            sp->ifaddr = sclone(ifbuf);
+        }
+    }
     sp->flags |= SOCKET_LISTENING | SOCKET_NODELAY;
-    sp->handlerMask |= SOCKET_READABLE;
+    socketRegisterInterest(sid, sp->handlerMask | SOCKET_READABLE);
     socketSetBlock(sid, (flags & SOCKET_BLOCK));
     if (sp->flags & SOCKET_NODELAY) {
         socketSetNoDelay(sid, 1);
@@ -281,7 +346,9 @@ PUBLIC void socketCloseConnection(int sid)
 
 
 /*
-    Accept a connection. Called as a callback on incoming connection.
+    Accept connections. Called as a callback on incoming connections. This drains the listen backlog up to
+    ME_GOAHEAD_LIMIT_ACCEPT connections per event so that bursts of connections do not each require a trip through
+    the event loop.
  */
 static void socketAccept(WebsSocket *sp)
 {
@@ -291,46 +358,67 @@ static void socketAccept(WebsSocket *sp)
     Socket                  newSock;
     size_t                  len;
     char                    ipbuf[1024];
-    int                     port, nid;
+    int                     port, nid, count, limit;
 
     assert(sp);
 
     /*
-        Accept the connection and prevent inheriting by children (F_SETFD)
+        A blocking listen socket would block once the backlog is drained, so only accept one connection at a time
      */
-    len = sizeof(addrStorage);
-    addr = (struct sockaddr*) &addrStorage;
-    if ((newSock = accept(sp->sock, addr, (Socklen*) &len)) == SOCKET_ERROR) {
-        return;
-    }
+    limit = (sp->flags & SOCKET_BLOCK) ? 1 : max(ME_GOAHEAD_LIMIT_ACCEPT, 1);
+
+    for (count = 0; count < limit; count++) {
+        /*
+            Accept the connection and prevent inheriting by children (F_SETFD)
+         */
+        len = sizeof(addrStorage);
+        addr = (struct sockaddr*) &addrStorage;
+#if LINUX && defined(SOCK_CLOEXEC) && defined(SOCK_NONBLOCK)
+        /*
+            Set close-on-exec and non-blocking mode atomically with the accept
+         */
+        if ((newSock = accept4(sp->sock, addr, (Socklen*) &len,
+                SOCK_CLOEXEC | ((sp->flags & SOCKET_BLOCK) ? 0 : SOCK_NONBLOCK))) == SOCKET_ERROR) {
+            return;
+        }
+#else
+        if ((newSock = accept(sp->sock, addr, (Socklen*) &len)) == SOCKET_ERROR) {
+            return;
+        }
 #if ME_COMPILER_HAS_FCNTL
-    fcntl(newSock, F_SETFD, FD_CLOEXEC);
+        fcntl(newSock, F_SETFD, FD_CLOEXEC);
+#endif
 #endif
-    socketHighestFd = max(socketHighestFd, newSock);
+        socketHighestFd = max(socketHighestFd, newSock);
 
-    /*
-        Create a socket structure and insert into the socket list
-     */
-    nid = socketAlloc(sp->ip, sp->port, sp->accept, sp->flags);
-    if ((nsp = socketList[nid]) == 0) {
-        return;
-    }
-    assert(nsp);
-    nsp->sock = newSock;
-    nsp->flags &= ~SOCKET_LISTENING;
-    socketSetBlock(nid, (nsp->flags & SOCKET_BLOCK));
-    if (nsp->flags & SOCKET_NODELAY) {
-        socketSetNoDelay(nid, 1);
-    }
+        /*
+            Create a socket structure and insert into the socket list
+         */
+        if ((nid = socketAlloc(sp->ip, sp->port, sp->accept, sp->flags)) < 0) {
+            closesocket(newSock);
+            return;
+        }
+        nsp = socketList[nid];
+        assert(nsp);
+        nsp->sock = newSock;
+        nsp->flags &= ~SOCKET_LISTENING;
+#if !(LINUX && defined(SOCK_CLOEXEC) && defined(SOCK_NONBLOCK))
+        socketSetBlock(nid, (nsp->flags & SOCKET_BLOCK));
+#endif
+        if (nsp->flags & SOCKET_NODELAY) {
+            socketSetNoDelay(nid, 1);
+        }
 
-    /*
-        Call the user accept callback. The user must call socketCreateHandler to register for further events of interest.
-     */
-    if (sp->accept != NULL) {
-        /* Get the remote client address */
-        socketAddress(addr, (int) len, ipbuf, sizeof(ipbuf), &port);
-        if ((sp->accept)(nid, ipbuf, port, sp->sid) < 0) {
-            socketFree(nid);
+        /*
+            Call the user accept callback. The user must call socketCreateHandler to register for further events of
+            interest.
+         */
+        if (sp->accept != NULL) {
+            /* Get the remote client address */
+            socketAddress(addr, (int) len, ipbuf, sizeof(ipbuf), &port);
+            if ((sp->accept)(nid, ipbuf, port, sp->sid) < 0) {
+                socketFree(nid);
+            }
         }
     }
 }
@@ -349,6 +437,9 @@ PUBLIC void socketRegisterInterest(int sid, int handlerMask)
     if (sp->flags & SOCKET_BUFFERED_WRITE) {
         sp->handlerMask |= SOCKET_WRITABLE;
     }
+#if ME_GOAHEAD_EPOLL && LINUX
+    epollUpdate(sp);
+#endif
 }
 
 
@@ -495,10 +586,29 @@ PUBLIC int socketSelect(int sid, int timeout)
     return nEvents;
 }
 
-#else /* !ME_WIN_LIKE */
 
+PUBLIC int socketReopenEvents()
+{
+    return 0;
+}
+
+#else /* !ME_WIN_LIKE */
 
 PUBLIC int socketSelect(int sid, int timeout)
+{
+#if ME_GOAHEAD_EPOLL && LINUX
+    /*
+        Use epoll when servicing all sockets. Waiting on a single socket uses select.
+     */
+    if (sid < 0 && epollFd >= 0) {
+        return epollSockets(timeout);
+    }
+#endif
+    return selectSockets(sid, timeout);
+}
+
+
+static int selectSockets(int sid, int timeout)
 {
     WebsSocket      *sp;
     struct timeval  tv;
@@ -611,6 +721,173 @@ PUBLIC int socketSelect(int sid, int timeout)
     wfree(exceptFds);
     return nEvents;
 }
+
+#if ME_GOAHEAD_EPOLL && LINUX
+/*
+    Wait for events on all sockets using epoll. Sockets with events are recorded in readyList for socketProcess.
+ */
+static int epollSockets(int timeout)
+{
+    WebsSocket          *sp;
+    struct epoll_event  events[SOCKET_MAX_EVENTS];
+    int                 i, sid, nfds, mask;
+
+    /*
+        Reset events from the prior pass that were not consumed by a handler
+     */
+    for (i = 0; i < readyCount; i++) {
+        sid = readyList[i];
+        if (sid < socketMax && (sp = socketList[sid]) != NULL) {
+            sp->currentEvents = 0;
+        }
+    }
+    readyCount = 0;
+    if (reserviceCount > 0) {
+        timeout = 0;
+    }
+    if ((nfds = epoll_wait(epollFd, events, SOCKET_MAX_EVENTS, timeout)) < 0) {
+        if (errno != EINTR) {
+            error("Epoll wait failed, errno %d", errno);
+        }
+        nfds = 0;
+    }
+    for (i = 0; i < nfds; i++) {
+        sid = (int) events[i].data.u32;
+        if (sid >= socketMax || (sp = socketList[sid]) == NULL) {
+            continue;
+        }
+        mask = 0;
+        if (events[i].events & EPOLLIN) {
+            mask |= SOCKET_READABLE;
+        }
+        if (events[i].events & EPOLLOUT) {
+            mask |= SOCKET_WRITABLE;
+        }
+        if (events[i].events & EPOLLPRI) {
+            mask |= SOCKET_EXCEPTION;
+        }
+        if (events[i].events & (EPOLLERR | EPOLLHUP)) {
+            /*
+                Let the handler discover the error or EOF via the next read or write
+             */
+            mask |= (sp->handlerMask & (SOCKET_READABLE | SOCKET_WRITABLE)) | SOCKET_EXCEPTION;
+        }
+        if (mask && sp->currentEvents == 0) {
+            addSid(&readyList, &readyCount, &readySize, sid);
+        }
+        sp->currentEvents |= mask;
+    }
+    for (i = 0; i < reserviceCount; i++) {
+        sid = reserviceList[i];
+        if (sid >= socketMax || (sp = socketList[sid]) == NULL || !(sp->flags & SOCKET_RESERVICE)) {
+            continue;
+        }
+        sp->flags &= ~SOCKET_RESERVICE;
+        mask = sp->handlerMask & (SOCKET_READABLE | SOCKET_WRITABLE);
+        if (mask && sp->currentEvents == 0) {
+            addSid(&readyList, &readyCount, &readySize, sid);
+        }
+        sp->currentEvents |= mask;
+        nfds++;
+    }
+    reserviceCount = 0;
+    return nfds;
+}
+
+
+/*
+    Create a new epoll descriptor and re-register all sockets. Used by child processes after fork.
+ */
+PUBLIC int socketReopenEvents()
+{
+    WebsSocket  *sp;
+    int         sid;
+
+    if (epollFd >= 0) {
+        close(epollFd);
+        epollFd = -1;
+    }
+    if ((epollFd = epoll_create1(EPOLL_CLOEXEC)) < 0) {
+        error("Cannot create epoll descriptor, errno %d. Using select instead.", errno);
+    }
+    for (sid = 0; sid < socketMax; sid++) {
+        if ((sp = socketList[sid]) != NULL) {
+            sp->interestEvents = 0;
+            epollUpdate(sp);
+        }
+    }
+    readyCount = reserviceCount = 0;
+    return (epollFd < 0) ? -1 : 0;
+}
+
+
+/*
+    Update the epoll registration for a socket if its handler mask has changed
+ */
+static void epollUpdate(WebsSocket *sp)
+{
+    struct epoll_event  ev;
+    int                 op;
+
+    if (epollFd < 0 || sp->sock < 0 || sp->handlerMask == sp->interestEvents) {
+        return;
+    }
+    memset(&ev, 0, sizeof(ev));
+    if (sp->handlerMask & SOCKET_READABLE) {
+        ev.events |= EPOLLIN;
+    }
+    if (sp->handlerMask & SOCKET_WRITABLE) {
+        ev.events |= EPOLLOUT;
+    }
+    if (sp->handlerMask & SOCKET_EXCEPTION) {
+        ev.events |= EPOLLPRI;
+    }
+    ev.data.u32 = (uint) sp->sid;
+    if (sp->interestEvents == 0) {
+        op = EPOLL_CTL_ADD;
+    } else if (sp->handlerMask == 0) {
+        op = EPOLL_CTL_DEL;
+    } else {
+        op = EPOLL_CTL_MOD;
+    }
+    if (epoll_ctl(epollFd, op, sp->sock, &ev) < 0) {
+        if (op == EPOLL_CTL_ADD && errno == EEXIST) {
+            epoll_ctl(epollFd, EPOLL_CTL_MOD, sp->sock, &ev);
+        } else if (op != EPOLL_CTL_DEL) {
+            error("Cannot update epoll for socket %d, errno %d", sp->sock, errno);
+            return;
+        }
+    }
+    sp->interestEvents = sp->handlerMask;
+}
+
+
+/*
+    Append a socket ID to a growable list
+ */
+static int addSid(int **list, int *count, int *size, int sid)
+{
+    int     *newList, newSize;
+
+    if (*count >= *size) {
+        newSize = max(*size * 2, 16);
+        if ((newList = wrealloc(*list, newSize * sizeof(int))) == 0) {
+            return -1;
+        }
+        *list = newList;
+        *size = newSize;
+    }
+    (*list)[(*count)++] = sid;
+    return 0;
+}
+
+#else /* !ME_GOAHEAD_EPOLL */
+
+PUBLIC int socketReopenEvents()
+{
+    return 0;
+}
+#endif /* ME_GOAHEAD_EPOLL */
 #endif /* WINDOWS || CE */
 
 
@@ -619,6 +896,24 @@ PUBLIC void socketProcess()
     WebsSocket    *sp;
     int         sid;
 
+#if ME_GOAHEAD_EPOLL && LINUX
+    int         i;
+
+    if (epollFd >= 0) {
+        /*
+            Only visit sockets that had events. Handlers may free sockets, so validate each entry.
+         */
+        for (i = 0; i < readyCount; i++) {
+            sid = readyList[i];
+            if (sid < socketMax && (sp = socketList[sid]) != NULL) {
+                if (sp->currentEvents & sp->handlerMask) {
+                    socketDoEvent(sp);
+                }
+            }
+        }
+        return;
+    }
+#endif
     for (sid = 0; sid < socketMax; sid++) {
         if ((sp = socketList[sid]) != NULL) {
             if (sp->currentEvents & sp->handlerMask) {
@@ -632,22 +927,23 @@ PUBLIC void socketProcess()
 static void socketDoEvent(WebsSocket *sp)
 {
     int     sid;
+#if ME_GOAHEAD_STATS
+    int64   start, elapsed;
 
+    start = websGetHiResTicks();
+#endif
     assert(sp);
 
     sid = sp->sid;
-    if (sp->currentEvents & SOCKET_READABLE) {
-        if (sp->flags & SOCKET_LISTENING) {
-            socketAccept(sp);
-            sp->currentEvents = 0;
-            return;
-        }
-    }
-    /*
-        Now invoke the users socket handler. NOTE: the handler may delete the
-        socket, so we must be very careful after calling the handler.
-     */
-    if (sp->handler && (sp->handlerMask & sp->currentEvents)) {
+    if ((sp->currentEvents & SOCKET_READABLE) && (sp->flags & SOCKET_LISTENING)) {
+        socketAccept(sp);
+        sp->currentEvents = 0;
+
+    } else if (sp->handler && (sp->handlerMask & sp->currentEvents)) {
+        /*
+            Now invoke the users socket handler. NOTE: the handler may delete the
+            socket, so we must be very careful after calling the handler.
+         */
         (sp->handler)(sid, sp->handlerMask & sp->currentEvents, sp->handler_data);
         /*
             Make sure socket pointer is still valid, then reset the currentEvents.
@@ -656,6 +952,27 @@ static void socketDoEvent(WebsSocket *sp)
             sp->currentEvents = 0;
         }
     }
+#if ME_GOAHEAD_STATS
+    elapsed = websGetHiResTicks() - start;
+    handlerCount++;
+    handlerTime += elapsed;
+    handlerMax = max(handlerMax, elapsed);
+#endif
+}
+
+
+PUBLIC void socketGetHandlerStats(int64 *count, int64 *elapsed, int64 *worst, int reset)
+{
+#if ME_GOAHEAD_STATS
+    *count = handlerCount;
+    *elapsed = handlerTime;
+    *worst = handlerMax;
+    if (reset) {
+        handlerCount = handlerTime = handlerMax = 0;
+    }
+#else
+    *count = *elapsed = *worst = 0;
+#endif
 }
 
 
@@ -722,6 +1039,50 @@ PUBLIC int socketSetBlock(int sid, int on)
 }
 
 
+/*
+    Set the TCP cork behavior. Writes followed by more data are sent with MSG_MORE.
+ */
+PUBLIC int socketSetCork(int sid, bool on)
+{
+    WebsSocket  *sp;
+    int         oldCork;
+
+    if ((sp = socketPtr(sid)) == NULL) {
+        assert(0);
+        return 0;
+    }
+    oldCork = sp->flags & SOCKET_CORK;
+    if (on) {
+        sp->flags |= SOCKET_CORK;
+    } else {
+        sp->flags &= ~(SOCKET_CORK);
+        socketPush(sid);
+    }
+    return oldCork;
+}
+
+
+/*
+    Push data held back by a write with MSG_MORE. Clearing TCP_CORK sends any pending partial segment.
+ */
+PUBLIC void socketPush(int sid)
+{
+    WebsSocket  *sp;
+
+    if ((sp = socketPtr(sid)) == NULL || !(sp->flags & SOCKET_CORKED)) {
+        return;
+    }
+    sp->flags &= ~SOCKET_CORKED;
+#if defined(MSG_MORE) && defined(TCP_CORK)
+    {
+        int     cork;
+        cork = 0;
+        setsockopt(sp->sock, IPPROTO_TCP, TCP_CORK, (char*) &cork, sizeof(int));
+    }
+#endif
+}
+
+
 /*
     Set the TCP delay behavior (nagle algorithm)
  */
@@ -798,6 +1159,79 @@ PUBLIC ssize socketWrite(int sid, void *buf, ssize bufsize)
 }
 
 
+/*
+    Write a vector of blocks to a socket. On Unix systems this is a single sendmsg so headers, framing and body data
+    are sent together without first copying them into one buffer. Otherwise, each block is written in turn.
+    Returns a negative error code on errors, otherwise the number of bytes written.
+ */
+PUBLIC ssize socketWriteVector(int sid, WebsIOVec *iov, int count, bool more)
+{
+    WebsSocket  *sp;
+    ssize       written;
+    int         errCode, i;
+#if ME_UNIX_LIKE
+    struct iovec    vec[WEBS_MAX_IOVEC];
+    struct msghdr   msg;
+    int         flags;
+#else
+    ssize       sofar;
+#endif
+
+    assert(iov);
+    assert(0 <= count && count <= WEBS_MAX_IOVEC);
+
+    if ((sp = socketPtr(sid)) == NULL || count > WEBS_MAX_IOVEC) {
+        return -1;
+    }
+    if (sp->flags & SOCKET_EOF) {
+        return -1;
+    }
+#if ME_UNIX_LIKE
+    memset(&msg, 0, sizeof(msg));
+    for (i = 0; i < count; i++) {
+        vec[i].iov_base = iov[i].start;
+        vec[i].iov_len = iov[i].len;
+    }
+    msg.msg_iov = vec;
+    msg.msg_iovlen = count;
+    flags = MSG_NOSIGNAL;
+#if defined(MSG_MORE) && defined(TCP_CORK)
+    if (more && (sp->flags & SOCKET_CORK)) {
+        flags |= MSG_MORE;
+    }
+#endif
+    while ((written = sendmsg(sp->sock, &msg, flags)) < 0) {
+        errCode = socketGetError(sid);
+        if (errCode != EINTR) {
+            return -errCode;
+        }
+    }
+    if (more && (sp->flags & SOCKET_CORK)) {
+        sp->flags |= SOCKET_CORKED;
+    } else {
+        sp->flags &= ~SOCKET_CORKED;
+    }
+    return written;
+#else
+    sofar = 0;
+    for (i = 0; i < count; i++) {
+        if ((written = socketWrite(sid, iov[i].start, iov[i].len)) < 0) {
+            errCode = socketGetError(sid);
+            if (sofar && (errCode == EWOULDBLOCK || errCode == EAGAIN)) {
+                return sofar;
+            }
+            return written;
+        }
+        sofar += written;
+        if (written < iov[i].len) {
+            break;
+        }
+    }
+    return sofar;
+#endif
+}
+
+
 /*
     Read from a socket. Return the number of bytes read if successful. This may be less than the requested "bufsize" and
     may be zero. This routine may block if the socket is in blocking mode.
@@ -857,6 +1291,11 @@ PUBLIC void socketReservice(int sid)
     if ((sp = socketPtr(sid)) == NULL) {
         return;
     }
+#if ME_GOAHEAD_EPOLL && LINUX
+    if (!(sp->flags & SOCKET_RESERVICE)) {
+        addSid(&reserviceList, &reserviceCount, &reserviceSize, sid);
+    }
+#endif
     sp->flags |= SOCKET_RESERVICE;
 }
 
@@ -910,7 +1349,25 @@ PUBLIC int socketAlloc(cchar *ip, int port, SocketAccept accept, int flags)
     if (ip) {
         sp->ip = sclone(ip);
     }
-    sp->flags = flags & (SOCKET_BLOCK | SOCKET_LISTENING | SOCKET_NODELAY);
+    sp->flags = flags & (SOCKET_BLOCK | SOCKET_LISTENING | SOCKET_NODELAY | SOCKET_CORK);
+    return sid;
+}
+
+
+/*
+    Allocate a socket object for an existing descriptor such as a pipe or eventfd so it can be serviced by the event loop
+ */
+PUBLIC int socketAllocFd(Socket fd)
+{
+    WebsSocket  *sp;
+    int         sid;
+
+    if ((sid = socketAlloc(NULL, 0, NULL, 0)) < 0) {
+        return -1;
+    }
+    sp = socketList[sid];
+    sp->sock = fd;
+    socketHighestFd = max(socketHighestFd, fd);
     return sid;
 }
 
@@ -943,6 +1400,7 @@ PUBLIC void socketFree(int sid)
         closesocket(sp->sock);
     }
     wfree(sp->ip);
+    wfree(sp->ifaddr);
     wfree(sp);
     socketMax = wfreeHandle(&socketList, sid);
     /*
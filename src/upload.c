@@ -41,24 +41,33 @@ static bool uploadHandler(Webs *wp)
 }
 
 
+/*
+    Allocate the upload state from the request arena. It is released with the arena when the request completes.
+ */
 static void initUpload(Webs *wp)
 {
-    char    *boundary;
+    WebsUploadState     *up;
+    char                *boundary;
 
-    if (wp->uploadState == 0) {
-        wp->uploadState = UPLOAD_BOUNDARY;
-        if ((boundary = strstr(wp->contentType, "boundary=")) != 0) {
-            boundary += 9;
-            wfree(wp->boundary);
-            wp->boundary = sfmt("--%s", boundary);
-            wp->boundaryLen = strlen(wp->boundary);
-        }
-        if (wp->boundaryLen == 0 || *wp->boundary == '\0') {
-            websError(wp, HTTP_CODE_BAD_REQUEST, "Bad boundary");
-        } else {
-            websSetVar(wp, "UPLOAD_DIR", uploadDir);
-            wp->files = hashCreate(11);
-        }
+    if ((up = arenaAlloc(&wp->arena, sizeof(WebsUploadState))) == 0) {
+        websError(wp, HTTP_CODE_INTERNAL_SERVER_ERROR, "Cannot allocate upload state");
+        return;
+    }
+    memset(up, 0, sizeof(WebsUploadState));
+    up->fd = -1;
+    up->state = UPLOAD_BOUNDARY;
+    wp->uploadState = up;
+
+    if ((boundary = strstr(wp->contentType, "boundary=")) != 0) {
+        boundary += 9;
+        up->boundary = arenaFmt(&wp->arena, "--%s", boundary);
+        up->boundaryLen = strlen(up->boundary);
+    }
+    if (up->boundaryLen == 0 || *up->boundary == '\0') {
+        websError(wp, HTTP_CODE_BAD_REQUEST, "Bad boundary");
+    } else {
+        websSetVar(wp, "UPLOAD_DIR", uploadDir);
+        wp->files = hashCreate(11);
     }
 }
 
@@ -79,40 +88,52 @@ static void freeUploadFile(WebsUpload *up)
 
 PUBLIC void websFreeUpload(Webs *wp)
 {
-    WebsUpload  *up;
-    WebsKey     *s;
+    WebsUploadState *up;
+    WebsUpload      *file;
+    WebsKey         *s;
 
+    up = wp->uploadState;
     if (wp->files >= 0) {
         for (s = hashFirst(wp->files); s; s = hashNext(wp->files, s)) {
-            up = s->content.value.symbol;
-            freeUploadFile(up);
-            if (up == wp->currentFile) {
-                wp->currentFile = 0;
+            file = s->content.value.symbol;
+            freeUploadFile(file);
+            if (up && file == up->currentFile) {
+                up->currentFile = 0;
             }
         }
         hashFree(wp->files);
+        wp->files = -1;
     }
-    if (wp->currentFile) {
-        freeUploadFile(wp->currentFile);
-        wp->currentFile = 0;
-    }
-    if (wp->upfd >= 0) {
-        close(wp->upfd);
-        wp->upfd = -1;
+    if (up) {
+        if (up->currentFile) {
+            freeUploadFile(up->currentFile);
+            up->currentFile = 0;
+        }
+        if (up->fd >= 0) {
+            close(up->fd);
+            up->fd = -1;
+        }
     }
 }
 
 
 PUBLIC bool websProcessUploadData(Webs *wp)
 {
-    char    *line, *nextTok;
-    ssize   len, nbytes;
-    bool    canProceed;
+    WebsUploadState *up;
+    char            *line, *nextTok;
+    ssize           len, nbytes;
+    bool            canProceed;
 
+    if (wp->uploadState == 0) {
+        initUpload(wp);
+    }
+    if ((up = wp->uploadState) == 0) {
+        return 1;
+    }
     line = 0;
     canProceed = 1;
-    while (canProceed && !wp->finalized && wp->uploadState != UPLOAD_CONTENT_END) {
-        if  (wp->uploadState == UPLOAD_BOUNDARY || wp->uploadState == UPLOAD_CONTENT_HEADER) {
+    while (canProceed && !wp->finalized && up->state != UPLOAD_CONTENT_END) {
+        if  (up->state == UPLOAD_BOUNDARY || up->state == UPLOAD_CONTENT_HEADER) {
             /*
                 Parse the next input line
              */
@@ -132,11 +153,7 @@ PUBLIC bool websProcessUploadData(Webs *wp)
                 line[len - 1] = '\0';
             }
         }
-        switch (wp->uploadState) {
-        case 0:
-            initUpload(wp);
-            break;
-
+        switch (up->state) {
         case UPLOAD_BOUNDARY:
             processContentBoundary(wp, line);
             break;
@@ -147,7 +164,7 @@ PUBLIC bool websProcessUploadData(Webs *wp)
 
         case UPLOAD_CONTENT_DATA:
             canProceed = processContentData(wp);
-            if (bufLen(&wp->input) < wp->boundaryLen) {
+            if (bufLen(&wp->input) < up->boundaryLen) {
                 /*  Incomplete boundary - return to get more data */
                 canProceed = 0;
             }
@@ -164,28 +181,33 @@ PUBLIC bool websProcessUploadData(Webs *wp)
 
 static void processContentBoundary(Webs *wp, char *line)
 {
+    WebsUploadState *up;
+
     /*
         Expecting a multipart boundary string
      */
-    if (strncmp(wp->boundary, line, wp->boundaryLen) != 0) {
+    up = wp->uploadState;
+    if (strncmp(up->boundary, line, up->boundaryLen) != 0) {
         websError(wp, HTTP_CODE_BAD_REQUEST, "Bad upload state. Incomplete boundary");
 
-    } else if (line[wp->boundaryLen] && strcmp(&line[wp->boundaryLen], "--") == 0) {
-        wp->uploadState = UPLOAD_CONTENT_END;
+    } else if (line[up->boundaryLen] && strcmp(&line[up->boundaryLen], "--") == 0) {
+        up->state = UPLOAD_CONTENT_END;
 
     } else {
-        wp->uploadState = UPLOAD_CONTENT_HEADER;
+        up->state = UPLOAD_CONTENT_HEADER;
     }
 }
 
 
 static void processUploadHeader(Webs *wp, char *line)
 {
-    WebsUpload  *file;
-    char        *key, *headerTok, *rest, *nextPair, *value;
+    WebsUploadState *up;
+    WebsUpload      *file;
+    char            *key, *headerTok, *rest, *nextPair, *value;
 
+    up = wp->uploadState;
     if (line[0] == '\0') {
-        wp->uploadState = UPLOAD_CONTENT_DATA;
+        up->state = UPLOAD_CONTENT_DATA;
         return;
     }
     trace(7, "Header line: %s", line);
@@ -208,9 +230,7 @@ static void processUploadHeader(Webs *wp, char *line)
             ---boundary
          */
         key = rest;
-        wfree(wp->uploadVar);
-        wfree(wp->clientFilename);
-        wp->uploadVar = wp->clientFilename = 0;
+        up->var = up->clientFilename = 0;
         while (key && stok(key, ";\r\n", &nextPair)) {
 
             key = strim(key, " ", WEBS_TRIM_BOTH);
@@ -221,11 +241,10 @@ static void processUploadHeader(Webs *wp, char *line)
                 /* Nothing to do */
 
             } else if (scaselesscmp(key, "name") == 0) {
-                wfree(wp->uploadVar);
-                wp->uploadVar = sclone(value);
+                up->var = arenaClone(&wp->arena, value);
 
             } else if (scaselesscmp(key, "filename") == 0) {
-                if (wp->uploadVar == 0) {
+                if (up->var == 0) {
                     websError(wp, HTTP_CODE_BAD_REQUEST, "Bad upload state. Missing name field");
                     return;
                 }
@@ -235,40 +254,41 @@ static void processUploadHeader(Webs *wp, char *line)
                     wfree(value);
                     return;
                 }
-                wfree(wp->clientFilename);
-                wp->clientFilename = value;
+                up->clientFilename = arenaClone(&wp->arena, value);
+                wfree(value);
 
                 /*
                     Create the file to hold the uploaded data
                  */
-                wfree(wp->uploadTmp);
-                if ((wp->uploadTmp = websTempFile(uploadDir, "tmp")) == 0) {
+                if ((value = websTempFile(uploadDir, "tmp")) == 0) {
                     websError(wp, HTTP_CODE_INTERNAL_SERVER_ERROR,
-                        "Cannot create upload temp file %s. Check upload temp dir %s", wp->uploadTmp, uploadDir);
+                        "Cannot create upload temp file. Check upload temp dir %s", uploadDir);
                     return;
                 }
-                trace(5, "File upload of: %s stored as %s", wp->clientFilename, wp->uploadTmp);
+                up->tmp = arenaClone(&wp->arena, value);
+                wfree(value);
+                trace(5, "File upload of: %s stored as %s", up->clientFilename, up->tmp);
 
-                if ((wp->upfd = open(wp->uploadTmp, O_WRONLY | O_CREAT | O_TRUNC | O_BINARY, 0600)) < 0) {
-                    websError(wp, HTTP_CODE_INTERNAL_SERVER_ERROR, "Cannot open upload temp file %s", wp->uploadTmp);
+                if ((up->fd = open(up->tmp, O_WRONLY | O_CREAT | O_TRUNC | O_BINARY, 0600)) < 0) {
+                    websError(wp, HTTP_CODE_INTERNAL_SERVER_ERROR, "Cannot open upload temp file %s", up->tmp);
                     return;
                 }
                 /*
                     Create the files[id]
                  */
-                freeUploadFile(wp->currentFile);
-                file = wp->currentFile = walloc(sizeof(WebsUpload));
+                freeUploadFile(up->currentFile);
+                file = up->currentFile = walloc(sizeof(WebsUpload));
                 memset(file, 0, sizeof(WebsUpload));
-                file->clientFilename = sclone(wp->clientFilename);
-                file->filename = sclone(wp->uploadTmp);
+                file->clientFilename = sclone(up->clientFilename);
+                file->filename = sclone(up->tmp);
             }
             key = nextPair;
         }
 
     } else if (scaselesscmp(headerTok, "Content-Type") == 0) {
-        if (wp->clientFilename) {
-            trace(5, "Set files[%s][CONTENT_TYPE] = %s", wp->uploadVar, rest);
-            wp->currentFile->contentType = sclone(rest);
+        if (up->clientFilename) {
+            trace(5, "Set files[%s][CONTENT_TYPE] = %s", up->var, rest);
+            up->currentFile->contentType = sclone(rest);
         }
     }
 }
@@ -276,30 +296,34 @@ static void processUploadHeader(Webs *wp, char *line)
 
 static void defineUploadVars(Webs *wp)
 {
+    WebsUploadState *up;
     WebsUpload      *file;
     char            key[64];
 
-    file = wp->currentFile;
-    fmt(key, sizeof(key), "FILE_CLIENT_FILENAME_%s", wp->uploadVar);
+    up = wp->uploadState;
+    file = up->currentFile;
+    fmt(key, sizeof(key), "FILE_CLIENT_FILENAME_%s", up->var);
     websSetVar(wp, key, file->clientFilename);
 
-    fmt(key, sizeof(key), "FILE_CONTENT_TYPE_%s", wp->uploadVar);
+    fmt(key, sizeof(key), "FILE_CONTENT_TYPE_%s", up->var);
     websSetVar(wp, key, file->contentType);
 
-    fmt(key, sizeof(key), "FILE_FILENAME_%s", wp->uploadVar);
+    fmt(key, sizeof(key), "FILE_FILENAME_%s", up->var);
     websSetVar(wp, key, file->filename);
 
-    fmt(key, sizeof(key), "FILE_SIZE_%s", wp->uploadVar);
+    fmt(key, sizeof(key), "FILE_SIZE_%s", up->var);
     websSetVarFmt(wp, key, "%d", (int) file->size);
 }
 
 
 static int writeToFile(Webs *wp, char *data, ssize len)
 {
+    WebsUploadState *up;
     WebsUpload      *file;
     ssize           rc;
 
-    file = wp->currentFile;
+    up = wp->uploadState;
+    file = up->currentFile;
 
     if ((file->size + len) > ME_GOAHEAD_LIMIT_UPLOAD) {
         websError(wp, HTTP_CODE_REQUEST_TOO_LARGE, "Uploaded file exceeds maximum %d", (int) ME_GOAHEAD_LIMIT_UPLOAD);
@@ -309,12 +333,12 @@ static int writeToFile(Webs *wp, char *data, ssize len)
         /*
             File upload. Write the file data.
          */
-        if ((rc = write(wp->upfd, data, (int) len)) != len) {
-            websError(wp, HTTP_CODE_INTERNAL_SERVER_ERROR, "Cannot write to upload temp file %s, rc %d", wp->uploadTmp, rc);
+        if ((rc = write(up->fd, data, (int) len)) != len) {
+            websError(wp, HTTP_CODE_INTERNAL_SERVER_ERROR, "Cannot write to upload temp file %s, rc %d", up->tmp, rc);
             return -1;
         }
         file->size += len;
-        trace(7, "uploadFilter: Wrote %d bytes to %s", len, wp->uploadTmp);
+        trace(7, "uploadFilter: Wrote %d bytes to %s", len, up->tmp);
     }
     return 0;
 }
@@ -322,27 +346,29 @@ static int writeToFile(Webs *wp, char *data, ssize len)
 
 static bool processContentData(Webs *wp)
 {
-    WebsUpload  *file;
-    WebsBuf     *content;
-    ssize       size, nbytes;
-    char        *data, *bp;
+    WebsUploadState *up;
+    WebsUpload      *file;
+    WebsBuf         *content;
+    ssize           size, nbytes;
+    char            *data, *bp;
 
+    up = wp->uploadState;
     content = &wp->input;
-    file = wp->currentFile;
+    file = up->currentFile;
 
     size = bufLen(content);
-    if (size < wp->boundaryLen) {
+    if (size < up->boundaryLen) {
         /*  Incomplete boundary. Return and get more data */
         return 0;
     }
     if ((bp = getBoundary(wp, content->servp, size)) == 0) {
-        trace(7, "uploadFilter: Got boundary filename %x", wp->clientFilename);
-        if (wp->clientFilename) {
+        trace(7, "uploadFilter: Got boundary filename %x", up->clientFilename);
+        if (up->clientFilename) {
             /*
                 No signature found yet. probably more data to come. Must handle split boundaries.
              */
             data = content->servp;
-            nbytes = ((int) (content->endp - data)) - (wp->boundaryLen - 1);
+            nbytes = ((int) (content->endp - data)) - (up->boundaryLen - 1);
             if (writeToFile(wp, content->servp, nbytes) < 0) {
                 /* Proceed to handle error */
                 return 1;
@@ -363,7 +389,7 @@ static bool processContentData(Webs *wp)
         if (nbytes >= 2 && data[nbytes - 2] == '\r' && data[nbytes - 1] == '\n') {
             nbytes -= 2;
         }
-        if (wp->clientFilename) {
+        if (up->clientFilename) {
             /*
                 Write the last bit of file data and add to the list of files and define environment variables
              */
@@ -371,32 +397,30 @@ static bool processContentData(Webs *wp)
                 /* Proceed to handle error */
                 return 1;
             }
-            hashEnter(wp->files, wp->uploadVar, valueSymbol(file), 0);
+            hashEnter(wp->files, up->var, valueSymbol(file), 0);
             defineUploadVars(wp);
 
-        } else if (wp->uploadVar) {
+        } else if (up->var) {
             /*
                 Normal string form data variables
              */
             data[nbytes] = '\0';
-            trace(5, "uploadFilter: form[%s] = %s", wp->uploadVar, data);
-            websDecodeUrl(wp->uploadVar, wp->uploadVar, -1);
+            trace(5, "uploadFilter: form[%s] = %s", up->var, data);
+            websDecodeUrl(up->var, up->var, -1);
             websDecodeUrl(data, data, -1);
-            websSetVar(wp, wp->uploadVar, data);
+            websSetVar(wp, up->var, data);
         }
     }
-    if (wp->clientFilename) {
+    if (up->clientFilename) {
         /*
             Now have all the data (we've seen the boundary)
          */
-        close(wp->upfd);
-        wp->upfd = -1;
-        wfree(wp->clientFilename);
-        wp->clientFilename = 0;
-        wfree(wp->uploadTmp);
-        wp->uploadTmp = 0;
+        close(up->fd);
+        up->fd = -1;
+        up->clientFilename = 0;
+        up->tmp = 0;
     }
-    wp->uploadState = UPLOAD_BOUNDARY;
+    up->state = UPLOAD_BOUNDARY;
     return 1;
 }
 
@@ -406,23 +430,24 @@ static bool processContentData(Webs *wp)
  */
 static char *getBoundary(Webs *wp, char *buf, ssize bufLen)
 {
-    char    *cp, *endp;
-    char    first;
+    WebsUploadState *up;
+    char            *cp, *endp;
+    char            first;
 
     assert(buf);
-
-    first = *wp->boundary;
+    up = wp->uploadState;
+    first = *up->boundary;
     cp = buf;
-    if (bufLen < wp->boundaryLen) {
+    if (bufLen < up->boundaryLen) {
         return 0;
     }
-    endp = cp + (bufLen - wp->boundaryLen) + 1;
+    endp = cp + (bufLen - up->boundaryLen) + 1;
     while (cp < endp) {
         cp = (char *) memchr(cp, first, endp - cp);
         if (!cp) {
             return 0;
         }
-        if (memcmp(cp, wp->boundary, wp->boundaryLen) == 0) {
+        if (memcmp(cp, up->boundary, up->boundaryLen) == 0) {
             return cp;
         }
         cp++;
@@ -0,0 +1,19 @@
+/*
+    async.tst - Asynchronous actions
+ */
+
+const HTTP = tget('TM_HTTP') || "127.0.0.1:8080"
+let http: Http = new Http
+
+http.get(HTTP + "/action/asyncTest?delay=10")
+ttrue(http.status == 200)
+ttrue(http.response.contains("async: 10"))
+http.close()
+
+//  Keep-alive connection is serviced again after the action completes
+http.get(HTTP + "/action/asyncTest?delay=10")
+ttrue(http.status == 200)
+http.get(HTTP + "/index.html")
+ttrue(http.status == 200)
+ttrue(http.response.contains("Hello /index.html"))
+http.close()
@@ -0,0 +1,31 @@
+/*
+    stats.tst - Event loop statistics
+ */
+
+const HTTP = tget('TM_HTTP') || "127.0.0.1:8080"
+let http: Http = new Http
+
+//  Complete a request so the request statistics are non-zero
+http.get(HTTP + "/index.html")
+ttrue(http.status == 200)
+http.close()
+
+http.get(HTTP + "/action/stats")
+ttrue(http.status == 200)
+ttrue(http.header("Content-Type") == "application/json")
+let stats = deserialize(http.response)
+ttrue(stats.loop.iterations > 0)
+ttrue(stats.loop.maxLag >= stats.loop.lastLag)
+ttrue(stats.pool.idle <= stats.pool.limit)
+ttrue(stats.pool.hits + stats.pool.misses > 0)
+ttrue(stats.requests.count > 0)
+ttrue(stats.requests.allocations >= 0)
+ttrue(stats.connections.open > 0)
+ttrue(stats.connections.idle < stats.connections.open)
+ttrue(stats.connections.memory >= stats.connections.open * stats.connections.idleSize)
+http.close()
+
+//  Read-only
+http.post(HTTP + "/action/stats", "reset=1")
+ttrue(http.status == 405)
+http.close()
@@ -0,0 +1,26 @@
+/*
+    transfer.tst - Blocks transferred to the response without copying
+ */
+
+const HTTP = tget('TM_HTTP') || "127.0.0.1:8080"
+let http: Http = new Http
+
+//  With a content length
+http.get(HTTP + "/action/transferTest?size=100000")
+ttrue(http.status == 200)
+ttrue(http.response.length == 100011)
+ttrue(http.response.startsWith("start\nabcdefghijklmnopqrstuvwxyzabc"))
+ttrue(http.response.endsWith("\nend\n"))
+http.close()
+
+//  With transfer chunk encoding
+http.get(HTTP + "/action/transferTest?size=100000&chunked=1")
+ttrue(http.status == 200)
+ttrue(http.response.length == 100011)
+ttrue(http.response.endsWith("\nend\n"))
+
+//  Connection is reused after the transfer
+http.get(HTTP + "/index.html")
+ttrue(http.status == 200)
+ttrue(http.response.contains("Hello /index.html"))
+http.close()
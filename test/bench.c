@@ -0,0 +1,317 @@
+/*
+    bench.c -- Microbenchmarks for GoAhead
+
+    Usage: bench [headers | write] [iterations]
+        headers     # Request header key dispatch via websGetHeaderId
+        write       # Formatted response output via websWrite
+
+    Run from the test directory so the route configuration is found. The write benchmark runs a server on
+    127.0.0.1:18180 with a client thread that requests pages from it over one keep-alive connection.
+
+    Copyright (c) All Rights Reserved. See details at the end of the file.
+ */
+
+/********************************* Includes ***********************************/
+
+#include    "goahead.h"
+
+#if ME_UNIX_LIKE
+#include    <pthread.h>
+#endif
+
+/********************************* Defines ************************************/
+
+#define BENCH_ENDPOINT  "http://127.0.0.1:18180"
+#define BENCH_PORT      18180
+#define BENCH_LINES     800
+
+/*********************************** Locals ***********************************/
+/*
+    Header keys captured from real browser requests
+ */
+static cchar *corpus[] = {
+    /* Chrome navigation */
+    "host", "connection", "cache-control", "sec-ch-ua", "sec-ch-ua-mobile", "sec-ch-ua-platform",
+    "upgrade-insecure-requests", "user-agent", "accept", "sec-fetch-site", "sec-fetch-mode", "sec-fetch-user",
+    "sec-fetch-dest", "referer", "accept-encoding", "accept-language", "cookie", "if-modified-since",
+    /* Firefox form post */
+    "host", "user-agent", "accept", "accept-language", "accept-encoding", "content-type", "content-length",
+    "origin", "connection", "referer", "cookie", "upgrade-insecure-requests", "sec-fetch-dest",
+    "sec-fetch-mode", "sec-fetch-site", "sec-fetch-user", "priority",
+    /* Safari XHR with credentials */
+    "host", "accept", "authorization", "sec-fetch-site", "accept-language", "accept-encoding", "sec-fetch-mode",
+    "user-agent", "referer", "connection", "sec-fetch-dest", "x-requested-with", "cookie",
+    /* curl chunked upload */
+    "host", "user-agent", "accept", "transfer-encoding", "content-type", "expect",
+};
+
+static int      finished;
+static int      pages;
+
+/*
+    Server time and allocations spent writing pages, indexed by write mode
+ */
+static int64    writeTime[2];
+static int64    writeAllocs[2];
+
+/***************************** Forward Declarations ***************************/
+
+static void benchHeaders(int iterations);
+static int strcmpHeaderId(cchar *key);
+#if ME_UNIX_LIKE
+static void benchWrite(int iterations);
+static void *client(void *arg);
+static int readResponse(int fd);
+static void writeAction(Webs *wp);
+#endif
+
+/*********************************** Code *************************************/
+
+MAIN(bench, int argc, char **argv, char **envp)
+{
+    cchar   *which;
+    int     iterations;
+
+    which = (argc > 1) ? argv[1] : "all";
+    iterations = (argc > 2) ? atoi(argv[2]) : 0;
+
+    if (smatch(which, "all") || smatch(which, "headers")) {
+        benchHeaders(iterations > 0 ? iterations : 2000000);
+    }
+#if ME_UNIX_LIKE
+    if (smatch(which, "all") || smatch(which, "write")) {
+        benchWrite(iterations > 0 ? iterations : 2000);
+    }
+#endif
+    return 0;
+}
+
+
+/*
+    The header dispatch from parseHeaders before websGetHeaderId was introduced
+ */
+static int strcmpHeaderId(cchar *key)
+{
+    if (strcmp(key, "user-agent") == 0) {
+        return WEBS_HDR_USER_AGENT;
+    } else if (scaselesscmp(key, "authorization") == 0) {
+        return WEBS_HDR_AUTHORIZATION;
+    } else if (strcmp(key, "connection") == 0) {
+        return WEBS_HDR_CONNECTION;
+    } else if (strcmp(key, "content-length") == 0) {
+        return WEBS_HDR_CONTENT_LENGTH;
+    } else if (strcmp(key, "content-type") == 0) {
+        return WEBS_HDR_CONTENT_TYPE;
+    } else if (strcmp(key, "cookie") == 0) {
+        return WEBS_HDR_COOKIE;
+    } else if (strcmp(key, "host") == 0) {
+        return WEBS_HDR_HOST;
+    } else if (strcmp(key, "if-modified-since") == 0) {
+        return WEBS_HDR_IF_MODIFIED_SINCE;
+    } else if (strcmp(key, "referer") == 0) {
+        return WEBS_HDR_REFERER;
+    } else if (strcmp(key, "transfer-encoding") == 0) {
+        return WEBS_HDR_TRANSFER_ENCODING;
+    }
+    return WEBS_HDR_OTHER;
+}
+
+
+/*
+    Compare websGetHeaderId against the strcmp chain over the corpus
+ */
+static void benchHeaders(int iterations)
+{
+    ssize   lens[sizeof(corpus) / sizeof(char*)];
+    int64   start, chain, table, sum;
+    int     count, i, j;
+
+    count = (int) (sizeof(corpus) / sizeof(char*));
+    for (j = 0; j < count; j++) {
+        lens[j] = slen(corpus[j]);
+        if (websGetHeaderId(corpus[j], lens[j]) != strcmpHeaderId(corpus[j])) {
+            printf("Mismatch for header \"%s\"\n", corpus[j]);
+            return;
+        }
+    }
+    /*
+        Sum the ids so the lookups cannot be optimized away
+     */
+    sum = 0;
+    start = websGetHiResTicks();
+    for (i = 0; i < iterations; i++) {
+        for (j = 0; j < count; j++) {
+            sum += strcmpHeaderId(corpus[j]);
+        }
+    }
+    chain = websGetHiResTicks() - start;
+
+    start = websGetHiResTicks();
+    for (i = 0; i < iterations; i++) {
+        for (j = 0; j < count; j++) {
+            sum -= websGetHeaderId(corpus[j], lens[j]);
+        }
+    }
+    table = websGetHiResTicks() - start;
+
+    printf("Headers %d x %d, checksum %lld\n", count, iterations, (long long) sum);
+    printf("strcmp chain            %8.3f sec  %6.2f ns/header\n", chain / 1e6,
+        chain * 1e3 / ((double) count * iterations));
+    printf("websGetHeaderId         %8.3f sec  %6.2f ns/header\n", table / 1e6,
+        table * 1e3 / ((double) count * iterations));
+}
+
+
+#if ME_UNIX_LIKE
+/*
+    Compare websWrite against formatting into a temporary allocation and writing it with websWriteBlock (the previous
+    websWrite). The page is the one generated by the bigTest JST function in test.c.
+ */
+static void benchWrite(int iterations)
+{
+    pthread_t   tid;
+    double      secs;
+    int         mode;
+
+    pages = iterations;
+    if (websOpen(NULL, "route.txt") < 0) {
+        error("Cannot initialize server");
+        return;
+    }
+    websDefineAction("benchWrite", writeAction);
+    if (websListen(BENCH_ENDPOINT) < 0) {
+        websClose();
+        return;
+    }
+    finished = 0;
+    if (pthread_create(&tid, NULL, client, NULL) != 0) {
+        websClose();
+        return;
+    }
+    websServiceEvents(&finished);
+    pthread_join(tid, NULL);
+    websClose();
+
+    printf("bigTest pages %d, %d lines each\n", pages, BENCH_LINES);
+    for (mode = 0; mode < 2; mode++) {
+        secs = writeTime[mode] / 1e6;
+        printf("%-23s %8.3f sec  %8.0f pages/sec  %6.1f allocs/page\n",
+            mode ? "websWrite" : "sfmt + websWriteBlock", secs, secs > 0 ? pages / secs : 0,
+            (double) writeAllocs[mode] / pages);
+    }
+}
+
+
+/*
+    Write the bigTest page. Mode "copy" formats each line with sfmt and writes it with websWriteBlock.
+ */
+static void writeAction(Webs *wp)
+{
+    char    *buf;
+    int64   start, allocs;
+    int     mode, i;
+
+    mode = smatch(websGetVar(wp, "mode", ""), "copy") ? 0 : 1;
+    websSetStatus(wp, 200);
+    websWriteHeaders(wp, -1, 0);
+    websWriteEndHeaders(wp);
+
+    start = websGetHiResTicks();
+    allocs = wallocCount();
+    if (mode == 0) {
+        websWriteBlock(wp, "<html>\n", 7);
+        for (i = 0; i < BENCH_LINES; i++) {
+            buf = sfmt(" Line: %05d %s", i, "aaaaaaaaaaaaaaaaaabbbbbbbbbbbbbbbbccccccccccccccccccddddddd<br/>\r\n");
+            websWriteBlock(wp, buf, slen(buf));
+            wfree(buf);
+        }
+        websWriteBlock(wp, "</html>\n", 8);
+    } else {
+        websWrite(wp, "<html>\n");
+        for (i = 0; i < BENCH_LINES; i++) {
+            websWrite(wp, " Line: %05d %s", i, "aaaaaaaaaaaaaaaaaabbbbbbbbbbbbbbbbccccccccccccccccccddddddd<br/>\r\n");
+        }
+        websWrite(wp, "</html>\n");
+    }
+    writeAllocs[mode] += wallocCount() - allocs;
+    writeTime[mode] += websGetHiResTicks() - start;
+    websDone(wp);
+}
+
+
+/*
+    Client thread. Request the pages in each mode over one keep-alive connection.
+ */
+static void *client(void *arg)
+{
+    struct sockaddr_in  addr;
+    char                request[128];
+    int                 fd, mode, i;
+
+    if ((fd = socket(AF_INET, SOCK_STREAM, 0)) < 0) {
+        finished = 1;
+        return NULL;
+    }
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(BENCH_PORT);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (connect(fd, (struct sockaddr*) &addr, sizeof(addr)) < 0) {
+        close(fd);
+        finished = 1;
+        return NULL;
+    }
+    for (mode = 0; mode < 2; mode++) {
+        fmt(request, sizeof(request), "GET /action/benchWrite?mode=%s HTTP/1.1\r\nHost: bench\r\n\r\n",
+            mode ? "write" : "copy");
+        for (i = 0; i < pages; i++) {
+            if (write(fd, request, slen(request)) < 0 || readResponse(fd) < 0) {
+                printf("Request failed\n");
+                break;
+            }
+        }
+    }
+    finished = 1;
+    close(fd);
+    return NULL;
+}
+
+
+/*
+    Read a chunked response up to and including the final empty chunk
+ */
+static int readResponse(int fd)
+{
+    char    buf[16 * 1024], tail[7];
+    ssize   len, n;
+
+    memset(tail, 0, sizeof(tail));
+    while ((len = read(fd, buf, sizeof(buf))) > 0) {
+        n = min(len, (ssize) sizeof(tail));
+        memmove(tail, &tail[n], sizeof(tail) - n);
+        memcpy(&tail[sizeof(tail) - n], &buf[len - n], n);
+        if (memcmp(tail, "\r\n0\r\n\r\n", sizeof(tail)) == 0) {
+            return 0;
+        }
+    }
+    return -1;
+}
+#endif /* ME_UNIX_LIKE */
+
+/*
+    @copy   default
+
+    Copyright (c) Embedthis Software LLC, 2003-2014. All Rights Reserved.
+
+    This software is distributed under commercial and open source licenses.
+    You may use the Embedthis Open Source license or you may acquire a
+    commercial license from Embedthis Software. You agree to be fully bound
+    by the terms of either license. Consult the LICENSE.md distributed with
+    this software for full details and other copyrights.
+
+    Local variables:
+    tab-width: 4
+    c-basic-offset: 4
+    End:
+    vim: sw=4 ts=4 expandtab
+*/
@@ -9,6 +9,7 @@
         --route routeFile      # Route configuration file
         --verbose              # Same as --log stderr:2
         --version              # Output version information
+        --workers count        # Number of worker processes
 
     Copyright (c) All Rights Reserved. See details at the end of the file.
  */
@@ -80,17 +81,19 @@ static int bigTest(int eid, Webs *wp, int argc, char **argv);
 static void actionTest(Webs *wp);
 static void setipaddress(Webs *wp);
 static void gettemp(Webs *wp);
-static void readPhase(Webs *wp);
+static char *readPhase(WebsAsync *async);
 static void channelSet(Webs *wp);
 static void rs422_normal(Webs *wp);
 static void rs422_loop_line(Webs *wp);
 static void rs422_loop_data(Webs *wp);
 static void rs422_tx_test(Webs *wp);
 static void system_reboot(Webs *wp);
-static void remove_cali(Webs *wp);
-static void cali_status(Webs *wp);
+static char *remove_cali(WebsAsync *async);
+static char *cali_status(WebsAsync *async);
+static char *asyncTest(WebsAsync *async);
 static void sessionTest(Webs *wp);
 static void showTest(Webs *wp);
+static void transferTest(Webs *wp);
 #if ME_GOAHEAD_UPLOAD && !ME_ROM
 static void uploadTest(Webs *wp);
 #endif
@@ -107,7 +110,7 @@ static void exitProc(void *data, int id);
 MAIN(goahead, int argc, char **argv, char **envp)
 {
     char    *argp, *auth, *home, *documents, *endpoints, *endpoint, *route, *tok, *lspec;
-    int     argind, duration;
+    int     argind, duration, rc;
 
     route = "route.txt";
     auth = "auth.txt";
@@ -155,6 +158,12 @@ MAIN(goahead, int argc, char **argv, char **envp)
             printf("%s\n", ME_VERSION);
             exit(0);
 
+#if ME_UNIX_LIKE
+        } else if (smatch(argp, "--workers") || smatch(argp, "-w")) {
+            if (argind >= argc) usage();
+            websSetWorkers(atoi(argv[++argind]));
+#endif
+
         } else if (*argp == '-' && isdigit((uchar) argp[1])) {
             lspec = sfmt("stdout:%s", &argp[1]);
             logSetPath(lspec);
@@ -214,16 +223,21 @@ MAIN(goahead, int argc, char **argv, char **envp)
     websDefineAction("setipaddress", setipaddress);
     websDefineAction("sessionTest", sessionTest);
     websDefineAction("gettemp", gettemp);
-    websDefineAction("readPhase", readPhase);
+    websDefineAsyncAction("readPhase", readPhase, NULL);
     websDefineAction("channelSet", channelSet);
     websDefineAction("rs422_normal", rs422_normal);
     websDefineAction("rs422_loop_line", rs422_loop_line);
     websDefineAction("rs422_loop_data", rs422_loop_data);
     websDefineAction("rs422_tx_test", rs422_tx_test);
     websDefineAction("system_reboot", system_reboot);
-    websDefineAction("remove_cali", remove_cali);
-    websDefineAction("cali_status", cali_status);
+    websDefineAsyncAction("remove_cali", remove_cali, NULL);
+    websDefineAsyncAction("cali_status", cali_status, NULL);
+    websDefineAsyncAction("asyncTest", asyncTest, NULL);
     websDefineAction("showTest", showTest);
+    websDefineAction("transferTest", transferTest);
+#if ME_GOAHEAD_STATS
+    websDefineAction("stats", websStatsAction);
+#endif
 #if ME_GOAHEAD_UPLOAD && !ME_ROM
     websDefineAction("uploadTest", uploadTest);
 #endif
@@ -238,6 +252,15 @@ MAIN(goahead, int argc, char **argv, char **envp)
             return -1;
         }
     }
+#endif
+#if ME_UNIX_LIKE
+    /*
+        In worker mode, the master supervises the workers till terminated
+     */
+    if ((rc = websStartWorkers(&finished)) != 0) {
+        websClose();
+        return rc < 0 ? -1 : 0;
+    }
 #endif
     if (duration) {
         printf("Running for %d secs\n", duration);
@@ -289,7 +312,11 @@ static void usage() {
         "    --log logFile:level    # Log to file file at verbosity level\n"
         "    --route routeFile      # Route configuration file\n"
         "    --verbose              # Same as --log stderr:2\n"
-        "    --version              # Output version information\n\n",
+        "    --version              # Output version information\n"
+#if ME_UNIX_LIKE
+        "    --workers count        # Number of worker processes\n"
+#endif
+        "\n",
         ME_TITLE, ME_NAME);
     exit(-1);
 }
@@ -467,11 +494,15 @@ unsigned int phase_read_back(unsigned int ch_no) //phase readback
 ////////////////////////////////////////
 
 
-static void readPhase(Webs *wp)
+/*
+    Runs on an action thread. The response is written by the event loop.
+ */
+static char *readPhase(WebsAsync *async)
 {
     cchar *theta, *phi;
-    theta = websGetVar(wp, "theta", NULL);
-    phi = websGetVar(wp, "phi", NULL);
+    char  *result, *cp;
+    theta = websGetAsyncVar(async, "theta", "0");
+    phi = websGetAsyncVar(async, "phi", "0");
     printf("theta is : %s\n", theta);
     printf("phi is: %s\n", phi);
 
@@ -481,6 +512,7 @@ static void readPhase(Webs *wp)
     phi1 = atoi(phi);
 
 
+    websLockRegisters();
     PL_REG_WRITE(ADDR_DBG_mode,1);  //OPEN THE DEBUG MODE
     DEBUG_ANGLE_SET(theta1, phi1);
 
@@ -492,15 +524,15 @@ static void readPhase(Webs *wp)
     for (i = 0; i < 23; i ++) {
         read_back[i] =  phase_read_back(i);
     }
+    PL_REG_WRITE(ADDR_DBG_mode,0);  //OPEN THE DEBUG MODE
+    websUnlockRegisters();
 
-    websSetStatus(wp, 200);
-    websWriteHeaders(wp, -1, 0);
-    websWriteEndHeaders(wp);
-    for(i=0; i<23; i++) {
-        websWrite(wp,"%02x ", read_back[i]);
+    result = walloc(23 * 3 + 1);
+    for (i = 0, cp = result; i < 23; i++, cp += 3) {
+        fmt(cp, 4, "%02x ", read_back[i]);
     }
-    websDone(wp);   
-    PL_REG_WRITE(ADDR_DBG_mode,0);  //OPEN THE DEBUG MODE
+    *cp = '\0';
+    return result;
 }
 
 /*------------------------------------------------------------*/
@@ -508,6 +540,7 @@ void  DEBUG_SGL_SET(unsigned int ch_no,unsigned int datt,unsigned int phase,unsi
 {      
         unsigned int set_data;
 
+        websLockRegisters();
         PL_REG_WRITE(ADDR_DBG_mode,1);  //OPEN THE DEBUG MODE
         
         set_data = ch_no<<16 | sw<<15 | phase<<8 | datt;
@@ -520,7 +553,7 @@ void  DEBUG_SGL_SET(unsigned int ch_no,unsigned int datt,unsigned int phase,unsi
         PL_REG_WRITE(ADDR_SGL_set_dv,0x00);  //write the ctrl to bus in the pl
 
         PL_REG_WRITE(ADDR_DBG_mode,0);  //CLOSE THE DEBUG MODE
-        
+        websUnlockRegisters();
 }
 
 static void channelSet(Webs *wp)
@@ -635,29 +668,35 @@ static void system_reboot(Webs *wp)
     system("reboot -f");
 }
 
-static void remove_cali(Webs *wp)
+static char *remove_cali(WebsAsync *async)
 {
     system("rm /run/media/mmcblk0p1/cali.bin");
+    return NULL;
 }
 
-static void cali_status(Webs *wp)
+static char *cali_status(WebsAsync *async)
 {
     int fd;
 
     fd = open("/run/media/mmcblk0p1/cali.bin", O_RDONLY);
+    if (fd < 0) {
+        return sclone("校验文件不存在");
+    }
+    close(fd);
+    return sclone("校验文件存在");
+}
 
-    websSetStatus(wp, 200);
-    websWriteHeaders(wp, -1, 0);
-    websWriteEndHeaders(wp);
 
-    if (fd < 0) {
-        websWrite(wp, "校验文件不存在", strlen("校验文件不存在"));
-    } else {
-        websWrite(wp, "校验文件存在", strlen("校验文件存在"));
-    } 
- 
-    websFlush(wp, 0);
-	websDone(wp);
+/*
+    Simulate a slow hardware operation on an action thread
+ */
+static char *asyncTest(WebsAsync *async)
+{
+    cchar   *delay;
+
+    delay = websGetAsyncVar(async, "delay", "100");
+    usleep(atoi(delay) * 1000);
+    return sfmt("<html><body><h2>async: %s</h2></body></html>\n", delay);
 }
 
 
@@ -670,6 +709,7 @@ static void showTest(Webs *wp)
     websWriteHeaders(wp, -1, 0);
     websWriteEndHeaders(wp);
     websWrite(wp, "<html><body><pre>\n");
+    websSetHeaderVars(wp);
     for (s = hashFirst(wp->vars); s; s = hashNext(wp->vars, s)) {
         websWrite(wp, "%s=%s\n", s->name.value.string, s->content.value.string);
     }
@@ -678,6 +718,34 @@ static void showTest(Webs *wp)
 }
 
 
+/*
+    Hand a block to the connection without copying. Use "chunked" to send with transfer chunk encoding.
+ */
+static void transferTest(Webs *wp)
+{
+    char    *buf;
+    ssize   size, i;
+    bool    chunked;
+
+    size = atoi(websGetVar(wp, "size", "65536"));
+    chunked = websGetVar(wp, "chunked", 0) != 0;
+    if ((buf = walloc(size + 1)) == 0) {
+        websError(wp, HTTP_CODE_INTERNAL_SERVER_ERROR, "Cannot allocate block");
+        return;
+    }
+    for (i = 0; i < size; i++) {
+        buf[i] = 'a' + (char) (i % 26);
+    }
+    websSetStatus(wp, 200);
+    websWriteHeaders(wp, chunked ? -1 : size + 11, 0);
+    websWriteEndHeaders(wp);
+    websWrite(wp, "start\n");
+    websTransferBlock(wp, buf, size);
+    websWrite(wp, "\nend\n");
+    websDone(wp);
+}
+
+
 #if ME_GOAHEAD_UPLOAD && !ME_ROM
 /*
     Dump the file upload details. Don't actually do anything with the uploaded file.
@@ -711,6 +779,7 @@ static void uploadTest(Webs *wp)
             wfree(upfile);
         }
         websWrite(wp, "\r\nVARS:\r\n");
+        websSetHeaderVars(wp);
         for (s = hashFirst(wp->vars); s; s = hashNext(wp->vars, s)) {
             websWrite(wp, "%s=%s\r\n", s->name.value.string, s->content.value.string);
         }